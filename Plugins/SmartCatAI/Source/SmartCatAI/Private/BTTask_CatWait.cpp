@@ -1,14 +1,22 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "BTTask_CatWait.h"
+#include "SmartCatAIStats.h"
 #include "SmartCatAIController.h"
 #include "AIController.h"
+#include "TimerManager.h"
 #include "BehaviorTree/BlackboardComponent.h"
 
 UBTTask_CatWait::UBTTask_CatWait()
 {
 	NodeName = "Cat Wait";
-	bNotifyTick = true;
+
+	// Timers drive the task, so waiting cats cost no BT tick time
+	bNotifyTick = false;
+	bNotifyTaskFinished = true;
+
+	// Runtime state lives in FBTCatWaitTaskMemory, so every cat shares this node
+	bCreateNodeInstance = false;
 
 	// Default idle actions
 	PossibleIdleActions.Add(ECatAnimationAction::Meow);
@@ -19,39 +27,119 @@ UBTTask_CatWait::UBTTask_CatWait()
 
 EBTNodeResult::Type UBTTask_CatWait::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
+	UWorld* World = OwnerComp.GetWorld();
+	if (!World)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	FBTCatWaitTaskMemory* Memory = CastInstanceNodeMemory<FBTCatWaitTaskMemory>(NodeMemory);
+
 	// Set random wait time
-	RemainingTime = FMath::RandRange(MinWaitTime, MaxWaitTime);
-	NextActionCheckTime = FMath::RandRange(1.0f, 3.0f);
+	const float WaitTime = FMath::RandRange(MinWaitTime, MaxWaitTime);
+	if (WaitTime <= 0.0f)
+	{
+		return EBTNodeResult::Succeeded;
+	}
+
+	const TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp(&OwnerComp);
+	World->GetTimerManager().SetTimer(Memory->WaitTimerHandle,
+		FTimerDelegate::CreateUObject(this, &UBTTask_CatWait::HandleWaitFinished, WeakOwnerComp), WaitTime, false);
+
+	if (PossibleIdleActions.Num() > 0)
+	{
+		ScheduleIdleActionCheck(OwnerComp, *Memory, FMath::RandRange(1.0f, 3.0f));
+	}
 
 	return EBTNodeResult::InProgress;
 }
 
-void UBTTask_CatWait::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+void UBTTask_CatWait::OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult)
 {
-	RemainingTime -= DeltaSeconds;
-	NextActionCheckTime -= DeltaSeconds;
+	// Covers success and abort alike: no timer may outlive the task
+	FBTCatWaitTaskMemory* Memory = CastInstanceNodeMemory<FBTCatWaitTaskMemory>(NodeMemory);
+	if (UWorld* World = OwnerComp.GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(Memory->WaitTimerHandle);
+		World->GetTimerManager().ClearTimer(Memory->IdleActionTimerHandle);
+	}
+
+	Super::OnTaskFinished(OwnerComp, NodeMemory, TaskResult);
+}
+
+void UBTTask_CatWait::HandleWaitFinished(TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp)
+{
+	SMARTCATAI_SCOPE_CYCLE_COUNTER(STAT_SmartCatAI_BTTaskEvent);
 
-	// Check for random idle action
-	if (NextActionCheckTime <= 0.0f && PossibleIdleActions.Num() > 0)
+	if (OwnerComp.IsValid())
 	{
-		NextActionCheckTime = FMath::RandRange(2.0f, 5.0f);
+		FinishLatentTask(*OwnerComp, EBTNodeResult::Succeeded);
+	}
+}
+
+void UBTTask_CatWait::HandleIdleActionCheck(TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp)
+{
+	SMARTCATAI_SCOPE_CYCLE_COUNTER(STAT_SmartCatAI_BTTaskEvent);
 
-		if (FMath::FRand() < IdleActionChance)
+	if (!OwnerComp.IsValid())
+	{
+		return;
+	}
+
+	uint8* NodeMemory = OwnerComp->GetNodeMemory(this, OwnerComp->FindInstanceContainingNode(this));
+	if (!NodeMemory)
+	{
+		return;
+	}
+
+	ScheduleIdleActionCheck(*OwnerComp, *CastInstanceNodeMemory<FBTCatWaitTaskMemory>(NodeMemory), FMath::RandRange(2.0f, 5.0f));
+
+	if (FMath::FRand() < IdleActionChance)
+	{
+		ASmartCatAIController* CatController = Cast<ASmartCatAIController>(OwnerComp->GetAIOwner());
+		if (CatController && !CatController->IsPlayingAction())
 		{
-			ASmartCatAIController* CatController = Cast<ASmartCatAIController>(OwnerComp.GetAIOwner());
-			if (CatController && !CatController->IsPlayingAction())
-			{
-				// Pick a random action
-				int32 Index = FMath::RandRange(0, PossibleIdleActions.Num() - 1);
-				CatController->TriggerAction(PossibleIdleActions[Index]);
-			}
+			// Pick a random action
+			int32 Index = FMath::RandRange(0, PossibleIdleActions.Num() - 1);
+			CatController->TriggerAction(PossibleIdleActions[Index]);
 		}
 	}
+}
+
+void UBTTask_CatWait::ScheduleIdleActionCheck(UBehaviorTreeComponent& OwnerComp, FBTCatWaitTaskMemory& Memory, float Delay)
+{
+	if (UWorld* World = OwnerComp.GetWorld())
+	{
+		const TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp(&OwnerComp);
+		World->GetTimerManager().SetTimer(Memory.IdleActionTimerHandle,
+			FTimerDelegate::CreateUObject(this, &UBTTask_CatWait::HandleIdleActionCheck, WeakOwnerComp), Delay, false);
+	}
+}
+
+uint16 UBTTask_CatWait::GetInstanceMemorySize() const
+{
+	return sizeof(FBTCatWaitTaskMemory);
+}
+
+void UBTTask_CatWait::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const
+{
+	InitializeNodeMemory<FBTCatWaitTaskMemory>(NodeMemory, InitType);
+}
+
+void UBTTask_CatWait::CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const
+{
+	CleanupNodeMemory<FBTCatWaitTaskMemory>(NodeMemory, CleanupType);
+}
+
+void UBTTask_CatWait::DescribeRuntimeValues(const UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTDescriptionVerbosity::Type Verbosity, TArray<FString>& Values) const
+{
+	Super::DescribeRuntimeValues(OwnerComp, NodeMemory, Verbosity, Values);
 
-	// Check if wait time is over
-	if (RemainingTime <= 0.0f)
+	const FBTCatWaitTaskMemory* Memory = CastInstanceNodeMemory<FBTCatWaitTaskMemory>(NodeMemory);
+	const UWorld* World = OwnerComp.GetWorld();
+	if (World && World->GetTimerManager().IsTimerActive(Memory->WaitTimerHandle))
 	{
-		FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
+		Values.Add(FString::Printf(TEXT("remaining: %.1fs"), World->GetTimerManager().GetTimerRemaining(Memory->WaitTimerHandle)));
 	}
 }
 
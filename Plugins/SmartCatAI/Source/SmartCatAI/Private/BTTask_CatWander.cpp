@@ -1,88 +1,290 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "BTTask_CatWander.h"
+#include "SmartCatAIStats.h"
 #include "SmartCatAIController.h"
+#include "SmartCatNavPointSubsystem.h"
 #include "AIController.h"
 #include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "NavFilters/NavigationQueryFilter.h"
 #include "Navigation/PathFollowingComponent.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "CoreGlobals.h"
+#include "HAL/IConsoleManager.h"
+#include "TimerManager.h"
+
+namespace SmartCatWander
+{
+	/** Async wander path queries allowed to start per frame; later requests wait for the next frame */
+	static int32 MaxNavQueriesPerFrame = 8;
+	static FAutoConsoleVariableRef CVarMaxNavQueriesPerFrame(
+		TEXT("SmartCat.Wander.MaxNavQueriesPerFrame"),
+		MaxNavQueriesPerFrame,
+		TEXT("Async nav queries the Cat Wander task may start per frame (<= 0: unlimited)."));
+
+	/** Frame the query count below belongs to (game thread only) */
+	static uint64 BudgetFrame = 0;
+	static int32 NumQueriesThisFrame = 0;
+
+	static bool TryConsumeNavQueryBudget()
+	{
+		if (BudgetFrame != GFrameCounter)
+		{
+			BudgetFrame = GFrameCounter;
+			NumQueriesThisFrame = 0;
+		}
+		if (MaxNavQueriesPerFrame > 0 && NumQueriesThisFrame >= MaxNavQueriesPerFrame)
+		{
+			return false;
+		}
+		++NumQueriesThisFrame;
+		return true;
+	}
+}
 
 UBTTask_CatWander::UBTTask_CatWander()
 {
 	NodeName = "Cat Wander";
-	bNotifyTick = true;
+
+	// Path following reports arrival, so wandering cats cost no BT tick time
+	bNotifyTick = false;
+	bNotifyTaskFinished = true;
+
+	// Runtime state lives in FBTCatWanderTaskMemory, so every cat shares this node
+	bCreateNodeInstance = false;
 }
 
 EBTNodeResult::Type UBTTask_CatWander::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
 {
 	AAIController* AIController = OwnerComp.GetAIOwner();
-	if (!AIController)
+	if (!AIController || !AIController->GetPawn())
 	{
 		return EBTNodeResult::Failed;
 	}
 
-	APawn* Pawn = AIController->GetPawn();
+	FBTCatWanderTaskMemory* Memory = CastInstanceNodeMemory<FBTCatWanderTaskMemory>(NodeMemory);
+	return StartPathQueryWithinBudget(OwnerComp, *Memory);
+}
+
+EBTNodeResult::Type UBTTask_CatWander::StartPathQueryWithinBudget(UBehaviorTreeComponent& OwnerComp, FBTCatWanderTaskMemory& Memory)
+{
+	if (SmartCatWander::TryConsumeNavQueryBudget())
+	{
+		return StartPathQuery(OwnerComp, Memory);
+	}
+
+	UWorld* World = OwnerComp.GetWorld();
+	if (!World)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	// Over budget: stay InProgress and try again next frame
+	Memory.RetryTimerHandle = World->GetTimerManager().SetTimerForNextTick(
+		FTimerDelegate::CreateUObject(this, &UBTTask_CatWander::HandleRetry, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp)));
+	return EBTNodeResult::InProgress;
+}
+
+EBTNodeResult::Type UBTTask_CatWander::StartPathQuery(UBehaviorTreeComponent& OwnerComp, FBTCatWanderTaskMemory& Memory)
+{
+	AAIController* AIController = OwnerComp.GetAIOwner();
+	APawn* Pawn = AIController ? AIController->GetPawn() : nullptr;
 	if (!Pawn)
 	{
 		return EBTNodeResult::Failed;
 	}
 
 	// Get navigation system
-	UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld());
+	UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(OwnerComp.GetWorld());
 	if (!NavSys)
 	{
 		return EBTNodeResult::Failed;
 	}
 
-	// Find a random point within the wander radius
-	FVector Origin = Pawn->GetActorLocation();
-	FNavLocation RandomLocation;
+	const FNavAgentProperties& AgentProps = AIController->GetNavAgentPropertiesRef();
+	const FVector Origin = Pawn->GetActorLocation();
+	ANavigationData* NavData = NavSys->GetNavDataForProps(AgentProps, Origin);
+	if (!NavData)
+	{
+		return EBTNodeResult::Failed;
+	}
+	FSharedConstNavQueryFilter Filter = UNavigationQueryFilter::GetQueryFilter(*NavData, AIController, AIController->GetDefaultNavigationFilterClass());
+
+	// Prefer a pooled point; fall back to a navmesh query while the pool is empty around the cat.
+	// Either way reachability is settled by the path query
+	FVector WanderLocation;
+	const USmartCatNavPointSubsystem* NavPoints = OwnerComp.GetWorld()->GetSubsystem<USmartCatNavPointSubsystem>();
+	if (!NavPoints || !NavPoints->FindWanderPoint(Origin, MinWanderRadius, MaxWanderRadius, static_cast<ECatNavPointTag>(WanderPointTags), WanderLocation))
+	{
+		FNavLocation RandomLocation;
+		const float Radius = FMath::RandRange(MinWanderRadius, MaxWanderRadius);
+		if (!NavSys->GetRandomPointInNavigableRadius(Origin, Radius, RandomLocation, NavData, Filter))
+		{
+			return EBTNodeResult::Failed;
+		}
+		WanderLocation = RandomLocation.Location;
+	}
+
+	FPathFindingQuery Query(AIController, *NavData, Origin, WanderLocation, Filter);
+
+	Memory.PathQueryID = NavSys->FindPathAsync(AgentProps, Query,
+		FNavPathQueryDelegate::CreateUObject(this, &UBTTask_CatWander::HandlePathFound, TWeakObjectPtr<UBehaviorTreeComponent>(&OwnerComp)));
+
+	return Memory.PathQueryID != INVALID_NAVQUERYID ? EBTNodeResult::InProgress : EBTNodeResult::Failed;
+}
 
-	// Try to find a valid navigable point
-	float Radius = FMath::RandRange(MinWanderRadius, MaxWanderRadius);
-	bool bFound = NavSys->GetRandomReachablePointInRadius(Origin, Radius, RandomLocation);
+void UBTTask_CatWander::HandleRetry(TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp)
+{
+	SMARTCATAI_SCOPE_CYCLE_COUNTER(STAT_SmartCatAI_BTTaskEvent);
 
-	if (!bFound)
+	if (!OwnerComp.IsValid())
 	{
-		return EBTNodeResult::Failed;
+		return;
 	}
 
-	TargetLocation = RandomLocation.Location;
-	bHasValidTarget = true;
+	uint8* NodeMemory = OwnerComp->GetNodeMemory(this, OwnerComp->FindInstanceContainingNode(this));
+	if (!NodeMemory)
+	{
+		return;
+	}
 
-	// Start moving to the location
-	AIController->MoveToLocation(TargetLocation, AcceptanceRadius);
+	FBTCatWanderTaskMemory* Memory = CastInstanceNodeMemory<FBTCatWanderTaskMemory>(NodeMemory);
+	Memory->RetryTimerHandle.Invalidate();
 
-	return EBTNodeResult::InProgress;
+	const EBTNodeResult::Type Result = StartPathQueryWithinBudget(*OwnerComp, *Memory);
+	if (Result != EBTNodeResult::InProgress)
+	{
+		FinishLatentTask(*OwnerComp, Result);
+	}
 }
 
-void UBTTask_CatWander::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+void UBTTask_CatWander::HandlePathFound(uint32 QueryID, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path, TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp)
 {
-	AAIController* AIController = OwnerComp.GetAIOwner();
-	if (!AIController)
+	SMARTCATAI_SCOPE_CYCLE_COUNTER(STAT_SmartCatAI_BTTaskEvent);
+
+	if (!OwnerComp.IsValid())
 	{
-		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
 		return;
 	}
 
-	// Check if we've reached the destination
-	APawn* Pawn = AIController->GetPawn();
-	if (Pawn && bHasValidTarget)
+	uint8* NodeMemory = OwnerComp->GetNodeMemory(this, OwnerComp->FindInstanceContainingNode(this));
+	FBTCatWanderTaskMemory* Memory = NodeMemory ? CastInstanceNodeMemory<FBTCatWanderTaskMemory>(NodeMemory) : nullptr;
+	if (!Memory || Memory->PathQueryID != QueryID)
 	{
-		float Distance = FVector::Dist(Pawn->GetActorLocation(), TargetLocation);
-		if (Distance <= AcceptanceRadius)
+		return;
+	}
+	Memory->PathQueryID = INVALID_NAVQUERYID;
+
+	// Partial paths mean the point is not reachable from here
+	AAIController* AIController = OwnerComp->GetAIOwner();
+	UPathFollowingComponent* PathComp = AIController ? AIController->GetPathFollowingComponent() : nullptr;
+	if (Result != ENavigationQueryResult::Success || !Path.IsValid() || Path->IsPartial() || !PathComp)
+	{
+		FinishLatentTask(*OwnerComp, EBTNodeResult::Failed);
+		return;
+	}
+
+	Memory->TargetLocation = Path->GetEndLocation();
+	Memory->bHasValidTarget = true;
+
+	// Start moving along the path we already have; no second pathfind
+	FAIMoveRequest MoveRequest(Memory->TargetLocation);
+	MoveRequest.SetAcceptanceRadius(AcceptanceRadius);
+	Path->EnableRecalculationOnInvalidation(true);
+
+	const FAIRequestID RequestID = AIController->RequestMove(MoveRequest, Path);
+	if (!RequestID.IsValid())
+	{
+		// The move could not start: the cat is idle, which the wander treats as done
+		FinishLatentTask(*OwnerComp, EBTNodeResult::Succeeded);
+		return;
+	}
+
+	Memory->MoveRequestID = RequestID;
+	Memory->MoveFinishedHandle = PathComp->OnRequestFinished.AddUObject(this, &UBTTask_CatWander::HandleMoveFinished, OwnerComp);
+}
+
+void UBTTask_CatWander::OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult)
+{
+	FBTCatWanderTaskMemory* Memory = CastInstanceNodeMemory<FBTCatWanderTaskMemory>(NodeMemory);
+	if (Memory->MoveFinishedHandle.IsValid())
+	{
+		const AAIController* AIController = OwnerComp.GetAIOwner();
+		if (UPathFollowingComponent* PathComp = AIController ? AIController->GetPathFollowingComponent() : nullptr)
+		{
+			PathComp->OnRequestFinished.Remove(Memory->MoveFinishedHandle);
+		}
+		Memory->MoveFinishedHandle.Reset();
+	}
+	if (Memory->PathQueryID != INVALID_NAVQUERYID)
+	{
+		if (UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(OwnerComp.GetWorld()))
 		{
-			FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
-			return;
+			NavSys->AbortAsyncFindPathRequest(Memory->PathQueryID);
 		}
+		Memory->PathQueryID = INVALID_NAVQUERYID;
 	}
+	if (UWorld* World = OwnerComp.GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(Memory->RetryTimerHandle);
+	}
+	Memory->MoveRequestID = FAIRequestID::InvalidRequest;
+	Memory->bHasValidTarget = false;
+
+	Super::OnTaskFinished(OwnerComp, NodeMemory, TaskResult);
+}
+
+void UBTTask_CatWander::HandleMoveFinished(FAIRequestID RequestID, const FPathFollowingResult& Result, TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp)
+{
+	SMARTCATAI_SCOPE_CYCLE_COUNTER(STAT_SmartCatAI_BTTaskEvent);
 
-	// Check if movement is still in progress
-	EPathFollowingStatus::Type Status = AIController->GetMoveStatus();
-	if (Status == EPathFollowingStatus::Idle)
+	if (!OwnerComp.IsValid())
+	{
+		return;
+	}
+
+	uint8* NodeMemory = OwnerComp->GetNodeMemory(this, OwnerComp->FindInstanceContainingNode(this));
+	if (!NodeMemory || !CastInstanceNodeMemory<FBTCatWanderTaskMemory>(NodeMemory)->MoveRequestID.IsEquivalent(RequestID))
+	{
+		return;
+	}
+
+	// Arrived, blocked or replaced by another move: the cat stopped, so the wander is done
+	FinishLatentTask(*OwnerComp, EBTNodeResult::Succeeded);
+}
+
+uint16 UBTTask_CatWander::GetInstanceMemorySize() const
+{
+	return sizeof(FBTCatWanderTaskMemory);
+}
+
+void UBTTask_CatWander::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const
+{
+	InitializeNodeMemory<FBTCatWanderTaskMemory>(NodeMemory, InitType);
+}
+
+void UBTTask_CatWander::CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const
+{
+	CleanupNodeMemory<FBTCatWanderTaskMemory>(NodeMemory, CleanupType);
+}
+
+void UBTTask_CatWander::DescribeRuntimeValues(const UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTDescriptionVerbosity::Type Verbosity, TArray<FString>& Values) const
+{
+	Super::DescribeRuntimeValues(OwnerComp, NodeMemory, Verbosity, Values);
+
+	const FBTCatWanderTaskMemory* Memory = CastInstanceNodeMemory<FBTCatWanderTaskMemory>(NodeMemory);
+	if (Memory->bHasValidTarget)
+	{
+		Values.Add(FString::Printf(TEXT("target: %s"), *Memory->TargetLocation.ToCompactString()));
+	}
+	else if (Memory->PathQueryID != INVALID_NAVQUERYID)
+	{
+		Values.Add(TEXT("waiting for path"));
+	}
+	else if (Memory->RetryTimerHandle.IsValid())
 	{
-		// Movement stopped for some reason
-		FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
+		Values.Add(TEXT("waiting for nav query budget"));
 	}
 }
 
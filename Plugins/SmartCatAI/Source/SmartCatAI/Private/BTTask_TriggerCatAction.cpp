@@ -1,15 +1,23 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "BTTask_TriggerCatAction.h"
+#include "SmartCatAIStats.h"
 #include "SmartCatAIController.h"
 #include "SmartCatAICharacter.h"
 #include "AIController.h"
+#include "TimerManager.h"
 #include "BehaviorTree/BlackboardComponent.h"
 
 UBTTask_TriggerCatAction::UBTTask_TriggerCatAction()
 {
 	NodeName = "Trigger Cat Action";
-	bNotifyTick = true;
+
+	// The anim instance reports completion, so waiting cats cost no BT tick time
+	bNotifyTick = false;
+	bNotifyTaskFinished = true;
+
+	// Runtime state lives in FBTTriggerCatActionTaskMemory, so every cat shares this node
+	bCreateNodeInstance = false;
 }
 
 EBTNodeResult::Type UBTTask_TriggerCatAction::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
@@ -23,42 +31,91 @@ EBTNodeResult::Type UBTTask_TriggerCatAction::ExecuteTask(UBehaviorTreeComponent
 	// Trigger the action
 	CatController->TriggerAction(ActionToTrigger);
 
-	// Reset wait timer
-	WaitTime = 0.0f;
-
 	if (!bWaitForCompletion)
 	{
 		return EBTNodeResult::Succeeded;
 	}
 
+	// Nothing playing (no cat anim instance, or ActionToTrigger is None): nothing to wait for
+	USmartCatAnimInstance* AnimInstance = CatController->GetCatAnimInstance();
+	if (!AnimInstance || !AnimInstance->IsPlayingAction())
+	{
+		return EBTNodeResult::Succeeded;
+	}
+
+	FBTTriggerCatActionTaskMemory* Memory = CastInstanceNodeMemory<FBTTriggerCatActionTaskMemory>(NodeMemory);
+	const TWeakObjectPtr<UBehaviorTreeComponent> WeakOwnerComp(&OwnerComp);
+
+	Memory->AnimInstance = AnimInstance;
+	Memory->ActionFinishedHandle = AnimInstance->OnActionFinished.AddUObject(
+		this, &UBTTask_TriggerCatAction::HandleActionFinished, WeakOwnerComp);
+
+	if (MaxWaitTime > 0.0f)
+	{
+		if (UWorld* World = OwnerComp.GetWorld())
+		{
+			World->GetTimerManager().SetTimer(Memory->TimeoutTimerHandle,
+				FTimerDelegate::CreateUObject(this, &UBTTask_TriggerCatAction::HandleTimeout, WeakOwnerComp), MaxWaitTime, false);
+		}
+	}
+
 	return EBTNodeResult::InProgress;
 }
 
-void UBTTask_TriggerCatAction::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+void UBTTask_TriggerCatAction::OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult)
 {
-	if (!bWaitForCompletion)
+	// Covers completion, timeout and abort alike: no binding may outlive the task
+	FBTTriggerCatActionTaskMemory* Memory = CastInstanceNodeMemory<FBTTriggerCatActionTaskMemory>(NodeMemory);
+	if (USmartCatAnimInstance* AnimInstance = Memory->AnimInstance.Get())
+	{
+		AnimInstance->OnActionFinished.Remove(Memory->ActionFinishedHandle);
+	}
+	Memory->AnimInstance.Reset();
+	Memory->ActionFinishedHandle.Reset();
+
+	if (UWorld* World = OwnerComp.GetWorld())
 	{
-		FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
-		return;
+		World->GetTimerManager().ClearTimer(Memory->TimeoutTimerHandle);
 	}
 
-	WaitTime += DeltaSeconds;
+	Super::OnTaskFinished(OwnerComp, NodeMemory, TaskResult);
+}
+
+void UBTTask_TriggerCatAction::HandleActionFinished(ECatAnimationAction Action, TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp)
+{
+	SMARTCATAI_SCOPE_CYCLE_COUNTER(STAT_SmartCatAI_BTTaskEvent);
 
-	// Check for timeout
-	if (MaxWaitTime > 0.0f && WaitTime >= MaxWaitTime)
+	if (OwnerComp.IsValid())
 	{
-		FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
-		return;
+		FinishLatentTask(*OwnerComp, EBTNodeResult::Succeeded);
 	}
+}
 
-	// Check if action is still playing
-	ASmartCatAIController* CatController = Cast<ASmartCatAIController>(OwnerComp.GetAIOwner());
-	if (CatController && !CatController->IsPlayingAction())
+void UBTTask_TriggerCatAction::HandleTimeout(TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp)
+{
+	SMARTCATAI_SCOPE_CYCLE_COUNTER(STAT_SmartCatAI_BTTaskEvent);
+
+	if (OwnerComp.IsValid())
 	{
-		FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
+		FinishLatentTask(*OwnerComp, EBTNodeResult::Succeeded);
 	}
 }
 
+uint16 UBTTask_TriggerCatAction::GetInstanceMemorySize() const
+{
+	return sizeof(FBTTriggerCatActionTaskMemory);
+}
+
+void UBTTask_TriggerCatAction::InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const
+{
+	InitializeNodeMemory<FBTTriggerCatActionTaskMemory>(NodeMemory, InitType);
+}
+
+void UBTTask_TriggerCatAction::CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const
+{
+	CleanupNodeMemory<FBTTriggerCatActionTaskMemory>(NodeMemory, CleanupType);
+}
+
 FString UBTTask_TriggerCatAction::GetStaticDescription() const
 {
 	return FString::Printf(TEXT("Trigger Action: %s%s"),
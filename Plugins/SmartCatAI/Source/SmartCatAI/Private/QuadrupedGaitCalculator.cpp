@@ -1,6 +1,9 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "QuadrupedGaitCalculator.h"
+#include "QuadrupedGaitCore.h"
+#include "SmartCatAIStats.h"
+#include "Async/ParallelFor.h"
 
 void UQuadrupedGaitCalculator::UpdateGaitState(
 	FQuadrupedGaitState& State,
@@ -12,172 +15,62 @@ void UQuadrupedGaitCalculator::UpdateGaitState(
 	State.DebugSpeed = Speed;
 
 	// Auto-detect gait based on speed
-	if (Speed < Config.StrollSpeed)
-	{
-		State.DetectedGait = EQuadrupedGait::Stroll;
-	}
-	else if (Speed < Config.WalkSpeed)
-	{
-		State.DetectedGait = EQuadrupedGait::Walk;
-	}
-	else if (Speed < Config.TrotSpeed)
-	{
-		State.DetectedGait = EQuadrupedGait::Trot;
-	}
-	else
-	{
-		State.DetectedGait = EQuadrupedGait::Gallop;
-	}
-
-	// Calculate steps per second
-	float StepsPerSecond = 0.0f;
-	if (Config.StrideLength > 0.0f && Speed > 0.1f)
-	{
-		StepsPerSecond = Speed / Config.StrideLength;
-	}
+	State.DetectedGait = QuadrupedGaitCore::DetectGait(Speed, Config.StrollSpeed, Config.WalkSpeed, Config.TrotSpeed);
 
 	// Accumulate phase
-	if (Config.bProceduralGait && Speed > 0.1f)
-	{
-		float EffectiveMultiplier = FMath::Max(Config.GaitSpeedMultiplier, 0.1f);
-		State.AccumulatedPhase += StepsPerSecond * DeltaTime * EffectiveMultiplier;
-		State.AccumulatedPhase = FMath::Fmod(State.AccumulatedPhase, 1.0f);
-	}
+	State.AccumulatedPhase = QuadrupedGaitCore::AdvancePhase(
+		State.AccumulatedPhase, Speed, Config.StrideLength, Config.GaitSpeedMultiplier, DeltaTime, Config.bProceduralGait);
 
 	State.GaitCyclePhase = State.AccumulatedPhase;
 }
 
-void UQuadrupedGaitCalculator::GetPhaseOffsets(EQuadrupedGait Gait, float& OutFL, float& OutFR, float& OutBL, float& OutBR)
-{
-	switch (Gait)
-	{
-	case EQuadrupedGait::Stroll:
-	case EQuadrupedGait::Walk:
-		// 4-beat lateral sequence
-		OutFL = 0.25f;
-		OutFR = 0.75f;
-		OutBL = 0.0f;
-		OutBR = 0.5f;
-		break;
-
-	case EQuadrupedGait::Trot:
-		// 2-beat diagonal pairs
-		OutFL = 0.0f;
-		OutFR = 0.5f;
-		OutBL = 0.5f;
-		OutBR = 0.0f;
-		break;
-
-	case EQuadrupedGait::Gallop:
-		// Asymmetric bounding
-		OutFL = 0.55f;
-		OutFR = 0.45f;
-		OutBL = 0.05f;
-		OutBR = 0.0f;
-		break;
-
-	default:
-		OutFL = 0.25f;
-		OutFR = 0.75f;
-		OutBL = 0.0f;
-		OutBR = 0.5f;
-		break;
-	}
-}
-
-float UQuadrupedGaitCalculator::GetSwingDuration(EQuadrupedGait Gait)
-{
-	switch (Gait)
-	{
-	case EQuadrupedGait::Stroll:
-		return 0.2f;
-	case EQuadrupedGait::Walk:
-		return 0.25f;
-	case EQuadrupedGait::Trot:
-		return 0.4f;
-	case EQuadrupedGait::Gallop:
-		return 0.35f;
-	default:
-		return 0.25f;
-	}
-}
-
-float UQuadrupedGaitCalculator::CalculateStepCurve(float Phase, float SwingDuration)
+UQuadrupedGaitCalculator::FLegEvalContext UQuadrupedGaitCalculator::MakeLegEvalContext(
+	const FQuadrupedGaitState& State,
+	const FQuadrupedGaitConfig& Config,
+	const FVector& MoveDirection)
 {
-	if (Phase < SwingDuration)
-	{
-		float SwingProgress = Phase / SwingDuration;
-		return FMath::Sin(SwingProgress * PI);
-	}
-	return 0.0f;
+	FLegEvalContext Context;
+	Context.ActiveGait = Config.bAutoGait ? State.DetectedGait : Config.ManualGait;
+	Context.SwingDuration = QuadrupedGaitCore::GetSwingDuration(Context.ActiveGait);
+	Context.LiftHeightScale = Config.StepHeight * QuadrupedGaitCore::GetLiftSpeedFactor(Context.ActiveGait, State.DebugSpeed, Config.GallopSpeed);
+	Context.SafeMoveDir = MoveDirection.IsNearlyZero() ? FVector::ForwardVector : MoveDirection;
+	Context.MoveRotation = Context.SafeMoveDir.Rotation();
+	return Context;
 }
 
 FQuadrupedLegGaitOutput UQuadrupedGaitCalculator::CalculateLegOutput(
 	const FQuadrupedGaitState& State,
 	const FQuadrupedGaitConfig& Config,
 	const FVector& MoveDirection,
-	float PhaseOffset,
-	float SwingDuration)
+	const FLegEvalContext& Context,
+	float PhaseOffset)
 {
 	FQuadrupedLegGaitOutput Output;
 
 	const float Speed = State.DebugSpeed;
-	const EQuadrupedGait ActiveGait = Config.bAutoGait ? State.DetectedGait : Config.ManualGait;
+	const float SwingDuration = Context.SwingDuration;
 
 	// Calculate leg phase
-	float LegPhase = FMath::Fmod(State.AccumulatedPhase + PhaseOffset, 1.0f);
+	const float LegPhase = QuadrupedGaitCore::GetLegPhase(State.AccumulatedPhase, PhaseOffset);
 	Output.StepPhase = LegPhase;
 	Output.bIsSwinging = (LegPhase < SwingDuration);
 
 	// Default rotation - toe points in movement direction
-	FVector SafeMoveDir = MoveDirection.IsNearlyZero() ? FVector::ForwardVector : MoveDirection;
-	Output.EffectorRotation = SafeMoveDir.Rotation();
+	Output.EffectorRotation = Context.MoveRotation;
 
-	if (!Config.bProceduralGait || Speed <= 0.1f)
+	if (!Config.bProceduralGait || Speed <= QuadrupedGaitCore::MinMoveSpeed)
 	{
 		Output.EffectorTransform = FTransform(Output.EffectorRotation.Quaternion(), Output.PositionOffset);
 		return Output;
 	}
 
 	// Calculate stride offset (forward/backward)
-	float HalfStride = Config.StrideLength * 0.5f;
-	float SwingProgress = 0.0f;
-
-	if (Output.bIsSwinging)
-	{
-		// Swing phase: foot moves from back to front
-		SwingProgress = LegPhase / SwingDuration;
-		Output.SwingProgress = SwingProgress;
-		Output.StrideOffset = FMath::Lerp(-HalfStride, HalfStride, SwingProgress);
-	}
-	else
-	{
-		// Stance phase: foot slides back
-		float StanceProgress = (LegPhase - SwingDuration) / (1.0f - SwingDuration);
-		Output.SwingProgress = 0.0f;
-		Output.StrideOffset = FMath::Lerp(HalfStride, -HalfStride, StanceProgress);
-	}
+	Output.StrideOffset = QuadrupedGaitCore::CalculateStrideOffset(LegPhase, SwingDuration, Config.StrideLength * 0.5f);
+	const float SwingProgress = Output.bIsSwinging ? LegPhase / SwingDuration : 0.0f;
+	Output.SwingProgress = SwingProgress;
 
-	// Calculate lift height with improved curve
-	// Foot lifts during first half of swing, comes back down during second half
-	if (Output.bIsSwinging)
-	{
-		// Use a curve that lifts and returns to ground
-		// Peak at 50% of swing, back to ground by 100%
-		float LiftCurve = FMath::Sin(SwingProgress * PI);
-		Output.LiftHeight = LiftCurve * Config.StepHeight;
-
-		// Scale lift height for gallop
-		if (ActiveGait == EQuadrupedGait::Gallop)
-		{
-			float SpeedFactor = FMath::Clamp(Speed / Config.GallopSpeed, 0.5f, 1.5f);
-			Output.LiftHeight *= SpeedFactor;
-		}
-	}
-	else
-	{
-		Output.LiftHeight = 0.0f;
-	}
+	// Lift height: peak at 50% of swing, back to ground by 100% (scaled up with speed for gallop)
+	Output.LiftHeight = QuadrupedGaitCore::CalculateStepCurve(LegPhase, SwingDuration) * Context.LiftHeightScale;
 
 	// Calculate toe pitch based on swing phase
 	// During swing: pitch up at start, level at peak, pitch down at end (reaching for ground)
@@ -205,7 +98,7 @@ FQuadrupedLegGaitOutput UQuadrupedGaitCalculator::CalculateLegOutput(
 	}
 
 	// Build rotation: yaw from movement direction, pitch from swing phase
-	Output.EffectorRotation = FRotator(ToePitch, SafeMoveDir.Rotation().Yaw, 0.0f);
+	Output.EffectorRotation = FRotator(ToePitch, Context.MoveRotation.Yaw, 0.0f);
 
 	// Build final position offset
 	Output.PositionOffset = MoveDirection * Output.StrideOffset + FVector(0.0f, 0.0f, Output.LiftHeight);
@@ -221,11 +114,8 @@ FQuadrupedLegGaitOutput UQuadrupedGaitCalculator::CalculateFrontLeftLeg(
 	const FQuadrupedGaitConfig& Config,
 	const FVector& MoveDirection)
 {
-	const EQuadrupedGait ActiveGait = Config.bAutoGait ? State.DetectedGait : Config.ManualGait;
-	float FL, FR, BL, BR;
-	GetPhaseOffsets(ActiveGait, FL, FR, BL, BR);
-	float SwingDuration = GetSwingDuration(ActiveGait);
-	return CalculateLegOutput(State, Config, MoveDirection, FL, SwingDuration);
+	const FLegEvalContext Context = MakeLegEvalContext(State, Config, MoveDirection);
+	return CalculateLegOutput(State, Config, MoveDirection, Context, QuadrupedGaitCore::GetPhaseOffsets(Context.ActiveGait)[EQuadrupedLeg::FrontLeft]);
 }
 
 FQuadrupedLegGaitOutput UQuadrupedGaitCalculator::CalculateFrontRightLeg(
@@ -233,11 +123,8 @@ FQuadrupedLegGaitOutput UQuadrupedGaitCalculator::CalculateFrontRightLeg(
 	const FQuadrupedGaitConfig& Config,
 	const FVector& MoveDirection)
 {
-	const EQuadrupedGait ActiveGait = Config.bAutoGait ? State.DetectedGait : Config.ManualGait;
-	float FL, FR, BL, BR;
-	GetPhaseOffsets(ActiveGait, FL, FR, BL, BR);
-	float SwingDuration = GetSwingDuration(ActiveGait);
-	return CalculateLegOutput(State, Config, MoveDirection, FR, SwingDuration);
+	const FLegEvalContext Context = MakeLegEvalContext(State, Config, MoveDirection);
+	return CalculateLegOutput(State, Config, MoveDirection, Context, QuadrupedGaitCore::GetPhaseOffsets(Context.ActiveGait)[EQuadrupedLeg::FrontRight]);
 }
 
 FQuadrupedLegGaitOutput UQuadrupedGaitCalculator::CalculateBackLeftLeg(
@@ -245,11 +132,8 @@ FQuadrupedLegGaitOutput UQuadrupedGaitCalculator::CalculateBackLeftLeg(
 	const FQuadrupedGaitConfig& Config,
 	const FVector& MoveDirection)
 {
-	const EQuadrupedGait ActiveGait = Config.bAutoGait ? State.DetectedGait : Config.ManualGait;
-	float FL, FR, BL, BR;
-	GetPhaseOffsets(ActiveGait, FL, FR, BL, BR);
-	float SwingDuration = GetSwingDuration(ActiveGait);
-	return CalculateLegOutput(State, Config, MoveDirection, BL, SwingDuration);
+	const FLegEvalContext Context = MakeLegEvalContext(State, Config, MoveDirection);
+	return CalculateLegOutput(State, Config, MoveDirection, Context, QuadrupedGaitCore::GetPhaseOffsets(Context.ActiveGait)[EQuadrupedLeg::BackLeft]);
 }
 
 FQuadrupedLegGaitOutput UQuadrupedGaitCalculator::CalculateBackRightLeg(
@@ -257,9 +141,104 @@ FQuadrupedLegGaitOutput UQuadrupedGaitCalculator::CalculateBackRightLeg(
 	const FQuadrupedGaitConfig& Config,
 	const FVector& MoveDirection)
 {
-	const EQuadrupedGait ActiveGait = Config.bAutoGait ? State.DetectedGait : Config.ManualGait;
-	float FL, FR, BL, BR;
-	GetPhaseOffsets(ActiveGait, FL, FR, BL, BR);
-	float SwingDuration = GetSwingDuration(ActiveGait);
-	return CalculateLegOutput(State, Config, MoveDirection, BR, SwingDuration);
+	const FLegEvalContext Context = MakeLegEvalContext(State, Config, MoveDirection);
+	return CalculateLegOutput(State, Config, MoveDirection, Context, QuadrupedGaitCore::GetPhaseOffsets(Context.ActiveGait)[EQuadrupedLeg::BackRight]);
+}
+
+void UQuadrupedGaitCalculator::CalculateAllLegs(
+	const FQuadrupedGaitState& State,
+	const FQuadrupedGaitConfig& Config,
+	const FVector& MoveDirection,
+	FQuadrupedLegGaitOutput (&OutLegs)[EQuadrupedLeg::Num])
+{
+	const FLegEvalContext Context = MakeLegEvalContext(State, Config, MoveDirection);
+
+	// Idle or procedural gait off: only phase and swing flag are filled, nothing to vectorize
+	if (!Config.bProceduralGait || State.DebugSpeed <= QuadrupedGaitCore::MinMoveSpeed)
+	{
+		const float (&PhaseOffsets)[EQuadrupedLeg::Num] = QuadrupedGaitCore::GetPhaseOffsets(Context.ActiveGait);
+		for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+		{
+			OutLegs[Leg] = CalculateLegOutput(State, Config, MoveDirection, Context, PhaseOffsets[Leg]);
+		}
+		return;
+	}
+
+	CalculateAllLegsVectorized(State, Config, MoveDirection, Context, OutLegs);
+}
+
+void UQuadrupedGaitCalculator::CalculateAllLegsScalar(
+	const FQuadrupedGaitState& State,
+	const FQuadrupedGaitConfig& Config,
+	const FVector& MoveDirection,
+	FQuadrupedLegGaitOutput (&OutLegs)[EQuadrupedLeg::Num])
+{
+	const FLegEvalContext Context = MakeLegEvalContext(State, Config, MoveDirection);
+
+	const float (&PhaseOffsets)[EQuadrupedLeg::Num] = QuadrupedGaitCore::GetPhaseOffsets(Context.ActiveGait);
+
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+	{
+		OutLegs[Leg] = CalculateLegOutput(State, Config, MoveDirection, Context, PhaseOffsets[Leg]);
+	}
+}
+
+void UQuadrupedGaitCalculator::CalculateAllLegsVectorized(
+	const FQuadrupedGaitState& State,
+	const FQuadrupedGaitConfig& Config,
+	const FVector& MoveDirection,
+	const FLegEvalContext& Context,
+	FQuadrupedLegGaitOutput (&OutLegs)[EQuadrupedLeg::Num])
+{
+	// Same math as CalculateLegOutput's animated path, one lane per leg (lane index = EQuadrupedLeg).
+	// The gait-specialized kernel is picked once here; nothing below branches on gait type.
+	QuadrupedGaitCore::FLegKernelOutput Kernel;
+	QuadrupedGaitCore::GetLegKernel(Context.ActiveGait)(
+		State.AccumulatedPhase, State.DebugSpeed, Config.StrideLength, Config.StepHeight, Config.GallopSpeed, Kernel);
+
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+	{
+		FQuadrupedLegGaitOutput& Output = OutLegs[Leg];
+		Output.StepPhase = Kernel.Phase[Leg];
+		Output.bIsSwinging = (Kernel.SwingBits & (1 << Leg)) != 0;
+		Output.SwingProgress = Kernel.SwingProgress[Leg];
+		Output.StrideOffset = Kernel.StrideOffset[Leg];
+		Output.LiftHeight = Kernel.LiftHeight[Leg];
+		Output.EffectorRotation = FRotator(Kernel.ToePitch[Leg], Context.MoveRotation.Yaw, 0.0f);
+		Output.PositionOffset = MoveDirection * Output.StrideOffset + FVector(0.0f, 0.0f, Output.LiftHeight);
+		Output.EffectorTransform = FTransform(Output.EffectorRotation.Quaternion(), Output.PositionOffset);
+	}
+}
+
+void UQuadrupedGaitCalculator::UpdateGaitStateBatch(
+	TArrayView<FQuadrupedGaitState> States,
+	TArrayView<const FQuadrupedGaitConfig> Configs,
+	TArrayView<const FVector> Velocities,
+	TArrayView<const FVector> MoveDirections,
+	TArrayView<const float> DeltaTimes,
+	TArrayView<FQuadrupedGaitLegOutputs> OutLegs)
+{
+	SMARTCATAI_SCOPE_CYCLE_COUNTER(STAT_SmartCatAI_GaitBatch);
+
+	const int32 NumCats = States.Num();
+	if (!ensure(Configs.Num() == NumCats && Velocities.Num() == NumCats
+		&& MoveDirections.Num() == NumCats && DeltaTimes.Num() == NumCats && OutLegs.Num() == NumCats))
+	{
+		return;
+	}
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumCats, BatchChunkSize);
+
+	// Each chunk owns a disjoint range of cats, so no synchronization is needed
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+	{
+		const int32 First = ChunkIndex * BatchChunkSize;
+		const int32 Last = FMath::Min(First + BatchChunkSize, NumCats);
+
+		for (int32 Cat = First; Cat < Last; ++Cat)
+		{
+			UpdateGaitState(States[Cat], Configs[Cat], Velocities[Cat], DeltaTimes[Cat]);
+			CalculateAllLegs(States[Cat], Configs[Cat], MoveDirections[Cat], OutLegs[Cat].Legs);
+		}
+	}, NumChunks <= 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
 }
@@ -0,0 +1,124 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "QuadrupedGaitCalculator.h"
+#include "QuadrupedGaitCore.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace QuadrupedGaitCalculatorTest
+{
+	/** Allowed difference between the kernel and the scalar reference (cm, degrees, phase) */
+	static constexpr float Tolerance = 1.0e-3f;
+
+	/** Legs this close (in phase) to a swing/stance switch are skipped: the flag may round either way there */
+	static constexpr float BoundaryMargin = 1.0e-4f;
+
+	/** Errors reported before the rest of the sweep is only counted */
+	static constexpr int32 MaxReportedMismatches = 16;
+
+	static bool IsNearSwingBoundary(float LegPhase, float SwingDuration)
+	{
+		return LegPhase < BoundaryMargin || LegPhase > 1.0f - BoundaryMargin
+			|| FMath::Abs(LegPhase - SwingDuration) < BoundaryMargin;
+	}
+
+	/** Name of the first field of A that differs from B beyond Tolerance, or null if they match */
+	static const TCHAR* FindMismatch(const FQuadrupedLegGaitOutput& A, const FQuadrupedLegGaitOutput& B)
+	{
+		if (A.bIsSwinging != B.bIsSwinging) { return TEXT("bIsSwinging"); }
+		if (!FMath::IsNearlyEqual(A.StepPhase, B.StepPhase, Tolerance)) { return TEXT("StepPhase"); }
+		if (!FMath::IsNearlyEqual(A.SwingProgress, B.SwingProgress, Tolerance)) { return TEXT("SwingProgress"); }
+		if (!FMath::IsNearlyEqual(A.StrideOffset, B.StrideOffset, Tolerance)) { return TEXT("StrideOffset"); }
+		if (!FMath::IsNearlyEqual(A.LiftHeight, B.LiftHeight, Tolerance)) { return TEXT("LiftHeight"); }
+		if (!A.PositionOffset.Equals(B.PositionOffset, Tolerance)) { return TEXT("PositionOffset"); }
+		if (!A.EffectorRotation.Equals(B.EffectorRotation, Tolerance)) { return TEXT("EffectorRotation"); }
+		if (!A.EffectorTransform.Equals(B.EffectorTransform, Tolerance)) { return TEXT("EffectorTransform"); }
+		return nullptr;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FQuadrupedGaitVectorizedTest, "SmartCatAI.Gait.VectorizedMatchesScalar",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FQuadrupedGaitVectorizedTest::RunTest(const FString& Parameters)
+{
+	using namespace QuadrupedGaitCalculatorTest;
+
+	// Phases off the k/N grid (gait offsets and swing durations sit on it), plus both sides of the wrap
+	TArray<float> Phases;
+	for (int32 Step = 0; Step < 64; ++Step)
+	{
+		Phases.Add((Step + 0.37f) / 64.0f);
+	}
+	Phases.Append({ 0.0f, 0.00001f, 0.9999f, 0.99999f, 1.0f - UE_KINDA_SMALL_NUMBER });
+
+	TArray<float> Speeds = { 0.0f, QuadrupedGaitCore::MinMoveSpeed, 0.5f };
+	for (float Speed = 5.0f; Speed <= 400.0f; Speed += 12.5f)
+	{
+		Speeds.Add(Speed);
+	}
+
+	const FVector MoveDirections[] = { FVector::ForwardVector, FVector(0.6f, -0.8f, 0.0f), FVector(-1.0f, 0.0f, 0.0f), FVector::ZeroVector };
+	const EQuadrupedGait Gaits[] = { EQuadrupedGait::Stroll, EQuadrupedGait::Walk, EQuadrupedGait::Trot, EQuadrupedGait::Gallop };
+
+	// Auto gait (detected from speed) plus each manual gait at every speed
+	TArray<FQuadrupedGaitConfig> Configs;
+	Configs.AddDefaulted();
+	for (const EQuadrupedGait Gait : Gaits)
+	{
+		FQuadrupedGaitConfig& Config = Configs.AddDefaulted_GetRef();
+		Config.bAutoGait = false;
+		Config.ManualGait = Gait;
+	}
+
+	int32 NumCompared = 0;
+	int32 NumMismatches = 0;
+	for (const FQuadrupedGaitConfig& Config : Configs)
+	{
+		for (const float Speed : Speeds)
+		{
+			for (const float Phase : Phases)
+			{
+				FQuadrupedGaitState State;
+				State.DebugSpeed = Speed;
+				State.DetectedGait = QuadrupedGaitCore::DetectGait(Speed, Config.StrollSpeed, Config.WalkSpeed, Config.TrotSpeed);
+				State.AccumulatedPhase = Phase;
+				State.GaitCyclePhase = Phase;
+
+				const EQuadrupedGait ActiveGait = Config.bAutoGait ? State.DetectedGait : Config.ManualGait;
+				const float SwingDuration = QuadrupedGaitCore::GetSwingDuration(ActiveGait);
+
+				for (const FVector& MoveDirection : MoveDirections)
+				{
+					FQuadrupedLegGaitOutput Scalar[EQuadrupedLeg::Num];
+					FQuadrupedLegGaitOutput Vectorized[EQuadrupedLeg::Num];
+					UQuadrupedGaitCalculator::CalculateAllLegsScalar(State, Config, MoveDirection, Scalar);
+					UQuadrupedGaitCalculator::CalculateAllLegs(State, Config, MoveDirection, Vectorized);
+
+					for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+					{
+						if (IsNearSwingBoundary(Scalar[Leg].StepPhase, SwingDuration))
+						{
+							continue;
+						}
+
+						++NumCompared;
+						const TCHAR* Field = FindMismatch(Scalar[Leg], Vectorized[Leg]);
+						if (Field && NumMismatches++ < MaxReportedMismatches)
+						{
+							AddError(FString::Printf(TEXT("%s differs: gait %s, speed %.2f, phase %.6f, leg %d, direction %s"),
+								Field, *UEnum::GetValueAsString(ActiveGait), Speed, Phase, Leg, *MoveDirection.ToString()));
+						}
+					}
+				}
+			}
+		}
+	}
+
+	TestTrue(TEXT("Compared any legs"), NumCompared > 0);
+	TestEqual(TEXT("Mismatching legs"), NumMismatches, 0);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
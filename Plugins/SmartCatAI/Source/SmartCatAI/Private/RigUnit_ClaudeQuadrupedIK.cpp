@@ -2,9 +2,21 @@
 
 #include "RigUnit_ClaudeQuadrupedIK.h"
 #include "Units/RigUnitContext.h"
+#include "QuadrupedGaitCore.h"
+#include "Engine/World.h"
+#include "SmartCatAIStats.h"
+
+// The rig's gait enum stays for existing rig assets; it must mirror EQuadrupedGait so the shared gait core can be used
+static_assert(static_cast<uint8>(EClaudeQuadrupedGait::Stroll) == static_cast<uint8>(EQuadrupedGait::Stroll)
+	&& static_cast<uint8>(EClaudeQuadrupedGait::Walk) == static_cast<uint8>(EQuadrupedGait::Walk)
+	&& static_cast<uint8>(EClaudeQuadrupedGait::Trot) == static_cast<uint8>(EQuadrupedGait::Trot)
+	&& static_cast<uint8>(EClaudeQuadrupedGait::Gallop) == static_cast<uint8>(EQuadrupedGait::Gallop),
+	"EClaudeQuadrupedGait must match EQuadrupedGait");
 
 FRigUnit_ClaudeQuadrupedIK_Execute()
 {
+	SMARTCATAI_SCOPE_CYCLE_COUNTER(STAT_SmartCatAI_RigUnitExecute);
+
 	// Early out if disabled
 	if (!bEnabled)
 	{
@@ -29,18 +41,17 @@ FRigUnit_ClaudeQuadrupedIK_Execute()
 
 	// Calculate body length (Clavicle to Thigh distance)
 	DebugBodyLength = 0.0f;
-	if (ClavicleBone.IsValid() && ThighBone.IsValid())
+	const bool bHasClavicle = CachedClavicle.UpdateCache(ClavicleBone, Hierarchy);
+	const bool bHasThigh = CachedThigh.UpdateCache(ThighBone, Hierarchy);
+	if (bHasClavicle && bHasThigh)
 	{
-		const FRigElementKey ClavicleKey = Hierarchy->GetFirstParent(ClavicleBone);
-		const FRigElementKey ThighKey = Hierarchy->GetFirstParent(ThighBone);
-
-		const FVector ClaviclePos = Hierarchy->GetGlobalTransform(ClavicleBone).GetLocation();
-		const FVector ThighPos = Hierarchy->GetGlobalTransform(ThighBone).GetLocation();
+		const FVector ClaviclePos = Hierarchy->GetGlobalTransform(CachedClavicle.GetIndex()).GetLocation();
+		const FVector ThighPos = Hierarchy->GetGlobalTransform(CachedThigh.GetIndex()).GetLocation();
 		DebugBodyLength = FVector::Dist(ClaviclePos, ThighPos);
 	}
 	else if (ClavicleBone.IsValid() || ThighBone.IsValid())
 	{
-		// One bone is set but not the other - output -1 as indicator
+		// One bone is set but not the other (or not in the hierarchy) - output -1 as indicator
 		DebugBodyLength = -1.0f;
 	}
 
@@ -49,267 +60,120 @@ FRigUnit_ClaudeQuadrupedIK_Execute()
 	DebugSpeed = Speed;
 
 	// Auto-detect gait based on speed thresholds
-	// Stroll: 0-75, Walk: 75-110, Trot: 110-145, Gallop: >145
-	if (Speed < StrollSpeed)
-	{
-		DetectedGait = EClaudeQuadrupedGait::Stroll;
-	}
-	else if (Speed < WalkSpeed)
-	{
-		DetectedGait = EClaudeQuadrupedGait::Walk;
-	}
-	else if (Speed < TrotSpeed)
-	{
-		DetectedGait = EClaudeQuadrupedGait::Trot;
-	}
-	else
-	{
-		DetectedGait = EClaudeQuadrupedGait::Gallop;
-	}
+	DetectedGait = static_cast<EClaudeQuadrupedGait>(QuadrupedGaitCore::DetectGait(Speed, StrollSpeed, WalkSpeed, TrotSpeed));
 
 	// Use detected gait if auto-switch enabled, otherwise use manual setting
 	const EClaudeQuadrupedGait ActiveGait = bAutoGait ? DetectedGait : Gait;
+	const EQuadrupedGait CoreGait = static_cast<EQuadrupedGait>(ActiveGait);
 
 	// Calculate gait cycle progression
-	float StepsPerSecond = 0.0f;
-	if (StrideLength > 0.0f && Speed > 0.1f)
-	{
-		StepsPerSecond = Speed / StrideLength;
-	}
-	DebugStepsPerSecond = StepsPerSecond;
-
-	// Accumulate phase
-	if (bProceduralGait && Speed > 0.1f)
-	{
-		float EffectiveMultiplier = FMath::Max(GaitSpeedMultiplier, 0.1f);
-		AccumulatedPhase += StepsPerSecond * DeltaTime * EffectiveMultiplier;
-		AccumulatedPhase = FMath::Fmod(AccumulatedPhase, 1.0f);
-	}
+	DebugStepsPerSecond = QuadrupedGaitCore::GetStepsPerSecond(Speed, StrideLength);
+	AccumulatedPhase = QuadrupedGaitCore::AdvancePhase(AccumulatedPhase, Speed, StrideLength, GaitSpeedMultiplier, DeltaTime, bProceduralGait);
 	GaitCyclePhase = AccumulatedPhase;
 
-	// Define leg phase offsets based on gait
-	// Phase offset determines when each leg is in its swing phase relative to the cycle
-	float PhaseOffset_FL = 0.0f;  // Front Left
-	float PhaseOffset_FR = 0.0f;  // Front Right
-	float PhaseOffset_BL = 0.0f;  // Back Left
-	float PhaseOffset_BR = 0.0f;  // Back Right
-
-	switch (ActiveGait)
-	{
-	case EClaudeQuadrupedGait::Stroll:
-		// Slow 4-beat gait, same pattern as walk but more relaxed timing
-		PhaseOffset_FL = 0.25f;  // Front Left
-		PhaseOffset_FR = 0.75f;  // Front Right
-		PhaseOffset_BL = 0.0f;   // Back Left
-		PhaseOffset_BR = 0.5f;   // Back Right
-		break;
-
-	case EClaudeQuadrupedGait::Walk:
-		// 4-beat lateral sequence: LH(0) -> LF(0.25) -> RH(0.5) -> RF(0.75)
-		// This creates the classic walking pattern
-		PhaseOffset_FL = 0.25f;  // Front Left
-		PhaseOffset_FR = 0.75f;  // Front Right
-		PhaseOffset_BL = 0.0f;   // Back Left
-		PhaseOffset_BR = 0.5f;   // Back Right
-		break;
-
-	case EClaudeQuadrupedGait::Trot:
-		// 2-beat diagonal: LF+RB together, RF+LB together
-		PhaseOffset_FL = 0.0f;   // Front Left
-		PhaseOffset_FR = 0.5f;   // Front Right
-		PhaseOffset_BL = 0.5f;   // Back Left
-		PhaseOffset_BR = 0.0f;   // Back Right
-		break;
-
-	case EClaudeQuadrupedGait::Gallop:
-		// Asymmetric bounding: Back legs lead, front legs follow
-		// Back legs nearly together, front legs nearly together, with suspension
-		PhaseOffset_FL = 0.55f;  // Front Left (slight offset from FR)
-		PhaseOffset_FR = 0.45f;  // Front Right
-		PhaseOffset_BL = 0.05f;  // Back Left (slight offset from BR)
-		PhaseOffset_BR = 0.0f;   // Back Right
-		break;
-	}
-
-	// Lambda to calculate step height based on phase
-	// Returns 0 when grounded, peaks at 0.5 of swing phase
-	auto CalculateStepCurve = [](float Phase, float SwingDuration) -> float
+	// Leg phase offsets and swing duration (fraction of the cycle the foot is in the air) for the gait
+	const float (&PhaseOffsets)[EQuadrupedLeg::Num] = QuadrupedGaitCore::GetPhaseOffsets(CoreGait);
+	const float SwingDuration = QuadrupedGaitCore::GetSwingDuration(CoreGait);
+
+	// Values shared by every leg; gait-dependent terms are resolved here so the leg solve never branches on gait
+	FClaudeQuadrupedLegSolveContext Context;
+	Context.AccumulatedPhase = AccumulatedPhase;
+	Context.SwingDuration = SwingDuration;
+	Context.Speed = Speed;
+	Context.MoveDirection = Velocity.GetSafeNormal2D();
+	Context.bProceduralGait = bProceduralGait;
+	Context.StrideLength = StrideLength;
+	Context.LiftHeightScale = StepHeight * QuadrupedGaitCore::GetLiftSpeedFactor(CoreGait, Speed, GallopSpeed);
+	Context.FootHeight = FootHeight;
+	Context.MaxIKOffset = MaxIKOffset;
+	Context.bAlignFootToGround = bAlignFootToGround;
+	Context.MaxFootAngle = MaxFootAngle;
+
+	// Per-leg inputs and outputs, indexed by EQuadrupedLeg
+	const FClaudeQuadrupedLegConfig* LegConfigs[EQuadrupedLeg::Num] = { &FrontLeftLeg, &FrontRightLeg, &BackLeftLeg, &BackRightLeg };
+	FCachedRigElement* CachedFeet[EQuadrupedLeg::Num] = { &CachedFrontLeftFoot, &CachedFrontRightFoot, &CachedBackLeftFoot, &CachedBackRightFoot };
+	FClaudeQuadrupedLegOutput* Outputs[EQuadrupedLeg::Num] = { &FrontLeftOutput, &FrontRightOutput, &BackLeftOutput, &BackRightOutput };
+
+	// Read every foot once through the cached indices and build its trace (from above to below the foot)
+	bool bFootValid[EQuadrupedLeg::Num];
+	FTransform FootTransforms[EQuadrupedLeg::Num];
+	FVector TraceStarts[EQuadrupedLeg::Num];
+	FVector TraceEnds[EQuadrupedLeg::Num];
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
 	{
-		// Phase 0 to SwingDuration is swing (foot in air)
-		// Phase SwingDuration to 1 is stance (foot on ground)
-		if (Phase < SwingDuration)
+		bFootValid[Leg] = LegConfigs[Leg]->FootBone.IsValid() && CachedFeet[Leg]->UpdateCache(LegConfigs[Leg]->FootBone, Hierarchy);
+		if (!bFootValid[Leg])
 		{
-			// Swing phase - lift the foot
-			float SwingProgress = Phase / SwingDuration;
-			// Use sine curve for smooth lift and lower
-			return FMath::Sin(SwingProgress * PI);
+			continue;
 		}
-		return 0.0f; // Stance phase - foot on ground
-	};
 
-	// Swing duration as fraction of gait cycle (how long foot is in air)
-	float SwingDuration = 0.25f; // Default for walk
-	switch (ActiveGait)
-	{
-	case EClaudeQuadrupedGait::Stroll:
-		SwingDuration = 0.2f;  // Shorter swing, more time on ground
-		break;
-	case EClaudeQuadrupedGait::Walk:
-		SwingDuration = 0.25f;
-		break;
-	case EClaudeQuadrupedGait::Trot:
-		SwingDuration = 0.4f;
-		break;
-	case EClaudeQuadrupedGait::Gallop:
-		SwingDuration = 0.35f;
-		break;
+		FootTransforms[Leg] = Hierarchy->GetGlobalTransform(CachedFeet[Leg]->GetIndex());
+		const FVector FootLocation = FootTransforms[Leg].GetLocation();
+		TraceStarts[Leg] = FootLocation + FVector(0.0f, 0.0f, TraceStartOffset);
+		TraceEnds[Leg] = FootLocation - FVector(0.0f, 0.0f, TraceEndOffset);
 	}
 
-	// Lambda to process a single leg
-	auto ProcessLeg = [&](
-		const FClaudeQuadrupedLegConfig& LegConfig,
-		FClaudeQuadrupedLegOutput& Output,
-		float PhaseOffset) -> float
-	{
-		if (!LegConfig.FootBone.IsValid())
-		{
-			Output.IKAlpha = 0.0f;
-			return 0.0f;
-		}
-
-		const FTransform FootTransform = Hierarchy->GetGlobalTransform(LegConfig.FootBone);
-		const FVector FootLocation = FootTransform.GetLocation();
-
-		// Calculate this leg's phase in the gait cycle
-		float LegPhase = FMath::Fmod(AccumulatedPhase + PhaseOffset, 1.0f);
-		Output.StepPhase = LegPhase;
-		Output.bIsSwinging = (LegPhase < SwingDuration);
-
-		// Calculate ground position (simple ground plane)
-		const float GroundZ = ComponentTransform.GetLocation().Z;
-
-		// Trace from foot position to find ground
-		const FVector TraceStart = FootLocation + FVector(0.0f, 0.0f, TraceStartOffset);
-		const FVector TraceEnd = FootLocation - FVector(0.0f, 0.0f, TraceEndOffset);
+	// Ground queries for all four legs in one pass with shared query params
+	bool bHits[EQuadrupedLeg::Num] = { false, false, false, false };
+	FVector HitPoints[EQuadrupedLeg::Num] = { FVector::ZeroVector, FVector::ZeroVector, FVector::ZeroVector, FVector::ZeroVector };
+	FVector HitNormals[EQuadrupedLeg::Num] = { FVector::UpVector, FVector::UpVector, FVector::UpVector, FVector::UpVector };
 
-		bool bHit = false;
-		FVector HitPoint = FVector::ZeroVector;
-		FVector HitNormal = FVector::UpVector;
+	const UWorld* World = bTraceWorld ? ExecuteContext.GetWorld() : nullptr;
+	if (World)
+	{
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ClaudeQuadrupedIKTrace), false, ExecuteContext.GetOwningActor());
+		QueryParams.bReturnPhysicalMaterial = false;
 
-		if (TraceStart.Z > GroundZ && TraceEnd.Z <= GroundZ)
+		const FTransform& ToWorld = ExecuteContext.GetToWorldSpaceTransform();
+		for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
 		{
-			float T = (TraceStart.Z - GroundZ) / (TraceStart.Z - TraceEnd.Z);
-			if (T >= 0.0f && T <= 1.0f)
+			if (!bFootValid[Leg])
 			{
-				HitPoint = FMath::Lerp(TraceStart, TraceEnd, T);
-				HitPoint.Z = GroundZ;
-				bHit = true;
+				continue;
 			}
-		}
-
-		float FootOffset = 0.0f;
-
-		if (bHit)
-		{
-			Output.bHitGround = true;
-			Output.GroundNormal = HitNormal;
-
-			// Base target is ground position plus foot height
-			FVector BaseTarget = HitPoint + FVector(0.0f, 0.0f, FootHeight);
 
-			// Add procedural gait lift
-			float LiftHeight = 0.0f;
-			if (bProceduralGait && Speed > 0.1f)
+			FHitResult Hit;
+			bHits[Leg] = World->LineTraceSingleByChannel(
+				Hit,
+				ExecuteContext.ToWorldSpace(TraceStarts[Leg]),
+				ExecuteContext.ToWorldSpace(TraceEnds[Leg]),
+				TraceChannel,
+				QueryParams
+			);
+			if (bHits[Leg])
 			{
-				LiftHeight = CalculateStepCurve(LegPhase, SwingDuration) * StepHeight;
-
-				// Scale lift height with speed (faster = higher steps for gallop)
-				if (ActiveGait == EClaudeQuadrupedGait::Gallop)
-				{
-					float SpeedFactor = FMath::Clamp(Speed / GallopSpeed, 0.5f, 1.5f);
-					LiftHeight *= SpeedFactor;
-				}
+				// Back into rig space, where the foot transforms and outputs live
+				HitPoints[Leg] = ExecuteContext.ToVMSpace(Hit.ImpactPoint);
+				HitNormals[Leg] = ToWorld.InverseTransformVectorNoScale(Hit.ImpactNormal);
 			}
-
-			// Calculate forward/backward offset based on swing phase
-			FVector SwingOffset = FVector::ZeroVector;
-			if (bProceduralGait && Speed > 0.1f)
-			{
-				// Use velocity direction for movement
-				FVector MoveDirection = Velocity.GetSafeNormal2D();
-
-				// Use full stride length
-				float HalfStride = StrideLength * 0.5f;
-
-				if (Output.bIsSwinging)
-				{
-					// Swing phase: foot moves from back to front
-					float SwingProgress = LegPhase / SwingDuration;
-					float ForwardOffset = FMath::Lerp(-HalfStride, HalfStride, SwingProgress);
-					SwingOffset = MoveDirection * ForwardOffset;
-				}
-				else
-				{
-					// Stance phase: foot stays planted, slides back relative to body motion
-					float StanceProgress = (LegPhase - SwingDuration) / (1.0f - SwingDuration);
-					float BackwardOffset = FMath::Lerp(HalfStride, -HalfStride, StanceProgress);
-					SwingOffset = MoveDirection * BackwardOffset;
-				}
-			}
-
-			// Final IK target
-			Output.IKTarget = BaseTarget + FVector(SwingOffset.X, SwingOffset.Y, LiftHeight);
-
-			// Calculate foot offset for pelvis adjustment
-			FootOffset = Output.IKTarget.Z - FootLocation.Z;
-			FootOffset = FMath::Clamp(FootOffset, -MaxIKOffset, MaxIKOffset);
-
-			// Foot rotation
-			if (bAlignFootToGround && !Output.bIsSwinging)
-			{
-				if (FVector::DotProduct(HitNormal, FVector::UpVector) < 0.99f)
-				{
-					const FQuat AlignmentRotation = FQuat::FindBetweenNormals(FVector::UpVector, HitNormal);
-					float Angle;
-					FVector Axis;
-					AlignmentRotation.ToAxisAndAngle(Axis, Angle);
-
-					const float MaxAngleRadians = FMath::DegreesToRadians(MaxFootAngle);
-					if (FMath::Abs(Angle) > MaxAngleRadians)
-					{
-						Angle = FMath::Sign(Angle) * MaxAngleRadians;
-					}
-					Output.FootRotation = FQuat(Axis, Angle) * FootTransform.GetRotation();
-				}
-				else
-				{
-					Output.FootRotation = FootTransform.GetRotation();
-				}
-			}
-			else
-			{
-				Output.FootRotation = FootTransform.GetRotation();
-			}
-
-			Output.IKAlpha = 1.0f;
 		}
-		else
+	}
+	else
+	{
+		// No world (e.g. asset preview): simple ground plane at the component height
+		const float GroundZ = ComponentTransform.GetLocation().Z;
+		for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
 		{
-			Output.bHitGround = false;
-			Output.GroundNormal = FVector::UpVector;
-			Output.IKTarget = FootLocation;
-			Output.FootRotation = FootTransform.GetRotation();
-			Output.IKAlpha = 0.0f;
+			bHits[Leg] = bFootValid[Leg] && TraceGroundPlane(TraceStarts[Leg], TraceEnds[Leg], GroundZ, HitPoints[Leg]);
 		}
+	}
 
-		return FootOffset;
-	};
+	// Solve each leg with its phase offset
+	float FootOffsets[EQuadrupedLeg::Num] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+	{
+		if (!bFootValid[Leg])
+		{
+			Outputs[Leg]->IKAlpha = 0.0f;
+			continue;
+		}
+		FootOffsets[Leg] = SolveLeg(Context, FootTransforms[Leg], PhaseOffsets[Leg], bHits[Leg], HitPoints[Leg], HitNormals[Leg], *Outputs[Leg]);
+	}
 
-	// Process each leg with its phase offset
-	float FootOffset_FrontLeft = ProcessLeg(FrontLeftLeg, FrontLeftOutput, PhaseOffset_FL);
-	float FootOffset_FrontRight = ProcessLeg(FrontRightLeg, FrontRightOutput, PhaseOffset_FR);
-	float FootOffset_BackLeft = ProcessLeg(BackLeftLeg, BackLeftOutput, PhaseOffset_BL);
-	float FootOffset_BackRight = ProcessLeg(BackRightLeg, BackRightOutput, PhaseOffset_BR);
+	const float FootOffset_FrontLeft = FootOffsets[EQuadrupedLeg::FrontLeft];
+	const float FootOffset_FrontRight = FootOffsets[EQuadrupedLeg::FrontRight];
+	const float FootOffset_BackLeft = FootOffsets[EQuadrupedLeg::BackLeft];
+	const float FootOffset_BackRight = FootOffsets[EQuadrupedLeg::BackRight];
 
 	// Calculate pelvis adjustment
 	{
@@ -328,7 +192,7 @@ FRigUnit_ClaudeQuadrupedIK_Execute()
 		}
 
 		// Add vertical bob for gallop
-		if (bProceduralGait && ActiveGait == EClaudeQuadrupedGait::Gallop && Speed > 0.1f)
+		if (bProceduralGait && ActiveGait == EClaudeQuadrupedGait::Gallop && Speed > QuadrupedGaitCore::MinMoveSpeed)
 		{
 			// Suspension phase bob
 			float BobPhase = FMath::Fmod(AccumulatedPhase * 2.0f, 1.0f);
@@ -356,3 +220,105 @@ FRigUnit_ClaudeQuadrupedIK_Execute()
 		));
 	}
 }
+
+bool FRigUnit_ClaudeQuadrupedIK::TraceGroundPlane(const FVector& TraceStart, const FVector& TraceEnd, float GroundZ, FVector& OutHitPoint)
+{
+	if (TraceStart.Z > GroundZ && TraceEnd.Z <= GroundZ)
+	{
+		float T = (TraceStart.Z - GroundZ) / (TraceStart.Z - TraceEnd.Z);
+		if (T >= 0.0f && T <= 1.0f)
+		{
+			OutHitPoint = FMath::Lerp(TraceStart, TraceEnd, T);
+			OutHitPoint.Z = GroundZ;
+			return true;
+		}
+	}
+	return false;
+}
+
+float FRigUnit_ClaudeQuadrupedIK::SolveLeg(
+	const FClaudeQuadrupedLegSolveContext& Context,
+	const FTransform& FootTransform,
+	float PhaseOffset,
+	bool bHit,
+	const FVector& HitPoint,
+	const FVector& HitNormal,
+	FClaudeQuadrupedLegOutput& Output)
+{
+	const FVector FootLocation = FootTransform.GetLocation();
+
+	// Calculate this leg's phase in the gait cycle
+	const float LegPhase = QuadrupedGaitCore::GetLegPhase(Context.AccumulatedPhase, PhaseOffset);
+	Output.StepPhase = LegPhase;
+	Output.bIsSwinging = (LegPhase < Context.SwingDuration);
+
+	const bool bAnimate = Context.bProceduralGait && Context.Speed > QuadrupedGaitCore::MinMoveSpeed;
+
+	float FootOffset = 0.0f;
+
+	if (bHit)
+	{
+		Output.bHitGround = true;
+		Output.GroundNormal = HitNormal;
+
+		// Base target is ground position plus foot height
+		FVector BaseTarget = HitPoint + FVector(0.0f, 0.0f, Context.FootHeight);
+
+		// Add procedural gait lift (faster = higher steps for gallop)
+		float LiftHeight = 0.0f;
+		FVector SwingOffset = FVector::ZeroVector;
+		if (bAnimate)
+		{
+			LiftHeight = QuadrupedGaitCore::CalculateStepCurve(LegPhase, Context.SwingDuration) * Context.LiftHeightScale;
+
+			// Forward/backward offset: swing moves back to front, stance slides back relative to body motion
+			SwingOffset = Context.MoveDirection * QuadrupedGaitCore::CalculateStrideOffset(LegPhase, Context.SwingDuration, Context.StrideLength * 0.5f);
+		}
+
+		// Final IK target
+		Output.IKTarget = BaseTarget + FVector(SwingOffset.X, SwingOffset.Y, LiftHeight);
+
+		// Calculate foot offset for pelvis adjustment
+		FootOffset = Output.IKTarget.Z - FootLocation.Z;
+		FootOffset = FMath::Clamp(FootOffset, -Context.MaxIKOffset, Context.MaxIKOffset);
+
+		// Foot rotation
+		if (Context.bAlignFootToGround && !Output.bIsSwinging)
+		{
+			if (FVector::DotProduct(HitNormal, FVector::UpVector) < 0.99f)
+			{
+				const FQuat AlignmentRotation = FQuat::FindBetweenNormals(FVector::UpVector, HitNormal);
+				float Angle;
+				FVector Axis;
+				AlignmentRotation.ToAxisAndAngle(Axis, Angle);
+
+				const float MaxAngleRadians = FMath::DegreesToRadians(Context.MaxFootAngle);
+				if (FMath::Abs(Angle) > MaxAngleRadians)
+				{
+					Angle = FMath::Sign(Angle) * MaxAngleRadians;
+				}
+				Output.FootRotation = FQuat(Axis, Angle) * FootTransform.GetRotation();
+			}
+			else
+			{
+				Output.FootRotation = FootTransform.GetRotation();
+			}
+		}
+		else
+		{
+			Output.FootRotation = FootTransform.GetRotation();
+		}
+
+		Output.IKAlpha = 1.0f;
+	}
+	else
+	{
+		Output.bHitGround = false;
+		Output.GroundNormal = FVector::UpVector;
+		Output.IKTarget = FootLocation;
+		Output.FootRotation = FootTransform.GetRotation();
+		Output.IKAlpha = 0.0f;
+	}
+
+	return FootOffset;
+}
@@ -1,6 +1,29 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "SmartCatAI.h"
+#include "SmartCatAIStats.h"
+
+DEFINE_STAT(STAT_SmartCatAI_AnimUpdate);
+DEFINE_STAT(STAT_SmartCatAI_AnimUpdateWorker);
+DEFINE_STAT(STAT_SmartCatAI_IKSlopeAdaptation);
+DEFINE_STAT(STAT_SmartCatAI_IKTerrainAdaptation);
+DEFINE_STAT(STAT_SmartCatAI_IKProcedural);
+DEFINE_STAT(STAT_SmartCatAI_Traces);
+DEFINE_STAT(STAT_SmartCatAI_GaitMath);
+DEFINE_STAT(STAT_SmartCatAI_GaitBatch);
+DEFINE_STAT(STAT_SmartCatAI_RigUnitExecute);
+DEFINE_STAT(STAT_SmartCatAI_BTTaskEvent);
+DEFINE_STAT(STAT_SmartCatAI_Perception);
+DEFINE_STAT(STAT_SmartCatAI_NavPointPool);
+DEFINE_STAT(STAT_SmartCatAI_NumTraces);
+DEFINE_STAT(STAT_SmartCatAI_NumActiveCats);
+
+namespace SmartCatAIStats
+{
+	std::atomic<bool> bCollectBenchmarkCounters(false);
+	std::atomic<uint64> BenchmarkAnimCycles(0);
+	std::atomic<uint32> BenchmarkNumTraces(0);
+}
 
 #define LOCTEXT_NAMESPACE "FSmartCatAIModule"
 
@@ -3,8 +3,13 @@
 #include "SmartCatAIController.h"
 #include "SmartCatAICharacter.h"
 #include "SmartCatAnimInstance.h"
+#include "SmartCatAIStats.h"
 #include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Enum.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Float.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
 #include "Perception/AIPerceptionComponent.h"
 #include "Perception/AISenseConfig_Sight.h"
 #include "Perception/AISenseConfig_Hearing.h"
@@ -64,14 +69,45 @@ void ASmartCatAIController::OnPossess(APawn* InPawn)
 	// Cache cat character reference
 	CatCharacter = Cast<ASmartCatAICharacter>(InPawn);
 
-	// Start behavior tree if configured
+	// Start behavior tree if configured (RunBehaviorTree writes the initial state)
 	if (bAutoStartBehaviorTree && CatBehaviorTree)
 	{
 		RunBehaviorTree(CatBehaviorTree);
-		UpdateBlackboard();
 	}
 }
 
+void ASmartCatAIController::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (DirtyBlackboardValues != 0)
+	{
+		FlushBlackboard();
+	}
+}
+
+bool ASmartCatAIController::RunBehaviorTree(UBehaviorTree* BTAsset)
+{
+	const bool bStarted = Super::RunBehaviorTree(BTAsset);
+
+	BlackboardKeys = FBlackboardKeyIDs();
+	if (const UBlackboardComponent* BB = GetBlackboardComponent())
+	{
+		BlackboardKeys.MoveTarget = BB->GetKeyID(BB_MoveTarget);
+		BlackboardKeys.LookTarget = BB->GetKeyID(BB_LookTarget);
+		BlackboardKeys.CurrentMood = BB->GetKeyID(BB_CurrentMood);
+		BlackboardKeys.CurrentBehavior = BB->GetKeyID(BB_CurrentBehavior);
+		BlackboardKeys.InterestLevel = BB->GetKeyID(BB_InterestLevel);
+		BlackboardKeys.CurrentAction = BB->GetKeyID(BB_CurrentAction);
+	}
+
+	// The new blackboard starts from the current state right away
+	MarkBlackboardDirty(DirtyAll);
+	FlushBlackboard();
+
+	return bStarted;
+}
+
 void ASmartCatAIController::OnUnPossess()
 {
 	// Stop behavior tree
@@ -95,7 +131,7 @@ void ASmartCatAIController::MoveToTarget(const FVector& Target)
 	// Update blackboard
 	if (UBlackboardComponent* BB = GetBlackboardComponent())
 	{
-		BB->SetValueAsVector(BB_MoveTarget, Target);
+		BB->SetValue<UBlackboardKeyType_Vector>(BlackboardKeys.MoveTarget, Target);
 	}
 
 	// Use the built-in MoveToLocation
@@ -105,7 +141,7 @@ void ASmartCatAIController::MoveToTarget(const FVector& Target)
 void ASmartCatAIController::TriggerBehavior(ECatBehavior Behavior)
 {
 	CurrentBehavior = Behavior;
-	UpdateBlackboard();
+	MarkBlackboardDirty(DirtyBehavior);
 
 	UE_LOG(LogTemp, Log, TEXT("SmartCatAI: Behavior changed to %d"), static_cast<int32>(Behavior));
 }
@@ -115,7 +151,7 @@ void ASmartCatAIController::SetMood(ECatMood NewMood)
 	if (CurrentMood != NewMood)
 	{
 		CurrentMood = NewMood;
-		UpdateBlackboard();
+		MarkBlackboardDirty(DirtyMood);
 
 		UE_LOG(LogTemp, Log, TEXT("SmartCatAI: Mood changed to %d"), static_cast<int32>(NewMood));
 	}
@@ -123,18 +159,15 @@ void ASmartCatAIController::SetMood(ECatMood NewMood)
 
 void ASmartCatAIController::TriggerAction(ECatAnimationAction Action)
 {
-	if (CatCharacter)
+	if (USmartCatAnimInstance* AnimInstance = GetCatAnimInstance())
 	{
-		if (USmartCatAnimInstance* AnimInstance = Cast<USmartCatAnimInstance>(CatCharacter->GetMesh()->GetAnimInstance()))
-		{
-			AnimInstance->TriggerAction(Action);
-		}
+		AnimInstance->TriggerAction(Action);
 	}
 
 	// Update blackboard
 	if (UBlackboardComponent* BB = GetBlackboardComponent())
 	{
-		BB->SetValueAsEnum(BB_CurrentAction, static_cast<uint8>(Action));
+		BB->SetValue<UBlackboardKeyType_Enum>(BlackboardKeys.CurrentAction, static_cast<uint8>(Action));
 	}
 }
 
@@ -145,15 +178,12 @@ void ASmartCatAIController::StopBehavior()
 
 	// Reset to idle behavior
 	CurrentBehavior = ECatBehavior::Idle;
-	UpdateBlackboard();
+	MarkBlackboardDirty(DirtyBehavior);
 
 	// Clear any current action
-	if (CatCharacter)
+	if (USmartCatAnimInstance* AnimInstance = GetCatAnimInstance())
 	{
-		if (USmartCatAnimInstance* AnimInstance = Cast<USmartCatAnimInstance>(CatCharacter->GetMesh()->GetAnimInstance()))
-		{
-			AnimInstance->ClearAction();
-		}
+		AnimInstance->ClearAction();
 	}
 }
 
@@ -168,18 +198,23 @@ bool ASmartCatAIController::IsMoving() const
 
 bool ASmartCatAIController::IsPlayingAction() const
 {
-	if (CatCharacter)
+	const USmartCatAnimInstance* AnimInstance = GetCatAnimInstance();
+	return AnimInstance && AnimInstance->IsPlayingAction();
+}
+
+USmartCatAnimInstance* ASmartCatAIController::GetCatAnimInstance() const
+{
+	if (CatCharacter && CatCharacter->GetMesh())
 	{
-		if (const USmartCatAnimInstance* AnimInstance = Cast<USmartCatAnimInstance>(CatCharacter->GetMesh()->GetAnimInstance()))
-		{
-			return AnimInstance->IsPlayingAction();
-		}
+		return Cast<USmartCatAnimInstance>(CatCharacter->GetMesh()->GetAnimInstance());
 	}
-	return false;
+	return nullptr;
 }
 
 void ASmartCatAIController::OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus Stimulus)
 {
+	SMARTCATAI_SCOPE_CYCLE_COUNTER(STAT_SmartCatAI_Perception);
+
 	if (!Actor || Actor == GetPawn())
 	{
 		return;
@@ -192,13 +227,12 @@ void ASmartCatAIController::OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus
 			*Actor->GetName(), Stimulus.Strength);
 
 		// Increase interest level
-		InterestLevel = FMath::Clamp(InterestLevel + 0.2f, 0.0f, 1.0f);
+		SetInterestLevel(InterestLevel + 0.2f);
 
 		// Update blackboard with look target
 		if (UBlackboardComponent* BB = GetBlackboardComponent())
 		{
-			BB->SetValueAsObject(BB_LookTarget, Actor);
-			BB->SetValueAsFloat(BB_InterestLevel, InterestLevel);
+			BB->SetValue<UBlackboardKeyType_Object>(BlackboardKeys.LookTarget, Actor);
 		}
 
 		// If hearing and calm, become alert
@@ -211,24 +245,41 @@ void ASmartCatAIController::OnTargetPerceptionUpdated(AActor* Actor, FAIStimulus
 	else
 	{
 		// Lost sight/hearing of something
-		InterestLevel = FMath::Clamp(InterestLevel - 0.1f, 0.0f, 1.0f);
+		SetInterestLevel(InterestLevel - 0.1f);
+	}
+}
 
-		if (UBlackboardComponent* BB = GetBlackboardComponent())
-		{
-			BB->SetValueAsFloat(BB_InterestLevel, InterestLevel);
-		}
+void ASmartCatAIController::SetInterestLevel(float NewInterestLevel)
+{
+	NewInterestLevel = FMath::Clamp(NewInterestLevel, 0.0f, 1.0f);
+	if (InterestLevel != NewInterestLevel)
+	{
+		InterestLevel = NewInterestLevel;
+		MarkBlackboardDirty(DirtyInterest);
 	}
 }
 
-void ASmartCatAIController::UpdateBlackboard()
+void ASmartCatAIController::FlushBlackboard()
 {
+	const uint8 DirtyValues = DirtyBlackboardValues;
+	DirtyBlackboardValues = 0;
+
 	UBlackboardComponent* BB = GetBlackboardComponent();
 	if (!BB)
 	{
 		return;
 	}
 
-	BB->SetValueAsEnum(BB_CurrentMood, static_cast<uint8>(CurrentMood));
-	BB->SetValueAsEnum(BB_CurrentBehavior, static_cast<uint8>(CurrentBehavior));
-	BB->SetValueAsFloat(BB_InterestLevel, InterestLevel);
+	if (DirtyValues & DirtyMood)
+	{
+		BB->SetValue<UBlackboardKeyType_Enum>(BlackboardKeys.CurrentMood, static_cast<uint8>(CurrentMood));
+	}
+	if (DirtyValues & DirtyBehavior)
+	{
+		BB->SetValue<UBlackboardKeyType_Enum>(BlackboardKeys.CurrentBehavior, static_cast<uint8>(CurrentBehavior));
+	}
+	if (DirtyValues & DirtyInterest)
+	{
+		BB->SetValue<UBlackboardKeyType_Float>(BlackboardKeys.InterestLevel, InterestLevel);
+	}
 }
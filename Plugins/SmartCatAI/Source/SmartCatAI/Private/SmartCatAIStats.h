@@ -0,0 +1,90 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include <atomic>
+
+/**
+ * Stats for the SmartCatAI plugin ("stat SmartCatAI"). Defined in SmartCatAI.cpp.
+ */
+DECLARE_STATS_GROUP(TEXT("SmartCatAI"), STATGROUP_SmartCatAI, STATCAT_Advanced);
+
+// Animation
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Anim Update (Game Thread)"), STAT_SmartCatAI_AnimUpdate, STATGROUP_SmartCatAI, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Anim Update (Worker)"), STAT_SmartCatAI_AnimUpdateWorker, STATGROUP_SmartCatAI, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("IK Slope Adaptation"), STAT_SmartCatAI_IKSlopeAdaptation, STATGROUP_SmartCatAI, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("IK Terrain Adaptation"), STAT_SmartCatAI_IKTerrainAdaptation, STATGROUP_SmartCatAI, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("IK Full Procedural"), STAT_SmartCatAI_IKProcedural, STATGROUP_SmartCatAI, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ground Traces"), STAT_SmartCatAI_Traces, STATGROUP_SmartCatAI, );
+
+// Gait
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Gait Math"), STAT_SmartCatAI_GaitMath, STATGROUP_SmartCatAI, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Gait Batch"), STAT_SmartCatAI_GaitBatch, STATGROUP_SmartCatAI, );
+
+// Control Rig
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Rig Unit Execute"), STAT_SmartCatAI_RigUnitExecute, STATGROUP_SmartCatAI, );
+
+// AI
+DECLARE_CYCLE_STAT_EXTERN(TEXT("BT Task Events"), STAT_SmartCatAI_BTTaskEvent, STATGROUP_SmartCatAI, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Perception Update"), STAT_SmartCatAI_Perception, STATGROUP_SmartCatAI, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Nav Point Pool Build"), STAT_SmartCatAI_NavPointPool, STATGROUP_SmartCatAI, );
+
+// Counters (reset every frame)
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Ground Traces Issued"), STAT_SmartCatAI_NumTraces, STATGROUP_SmartCatAI, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Active Cats"), STAT_SmartCatAI_NumActiveCats, STATGROUP_SmartCatAI, );
+
+/**
+ * Cycle stat plus a named Unreal Insights CPU scope. The Insights scope is also
+ * available in builds where stats are compiled out (Test).
+ *
+ * Expands to two scoped declarations, so it is a scope-level statement only: put it at the
+ * top of a braced block (function body, or `{ }` around the timed code), never as the lone
+ * body of an unbraced if/for/while.
+ */
+#define SMARTCATAI_SCOPE_CYCLE_COUNTER(Stat) \
+	TRACE_CPUPROFILER_EVENT_SCOPE(Stat); \
+	SCOPE_CYCLE_COUNTER(Stat)
+
+/**
+ * Totals read by the crowd benchmark (USmartCatBenchmarkSubsystem). Unlike the stats above these
+ * are available in every build configuration; they are only updated while a benchmark runs.
+ */
+namespace SmartCatAIStats
+{
+	extern std::atomic<bool> bCollectBenchmarkCounters;
+	extern std::atomic<uint64> BenchmarkAnimCycles;
+	extern std::atomic<uint32> BenchmarkNumTraces;
+
+	/** Adds the lifetime of the scope to BenchmarkAnimCycles (any thread) */
+	struct FBenchmarkAnimScope
+	{
+		FBenchmarkAnimScope()
+			: StartCycles(bCollectBenchmarkCounters.load(std::memory_order_relaxed) ? FPlatformTime::Cycles64() : 0)
+		{
+		}
+
+		~FBenchmarkAnimScope()
+		{
+			if (StartCycles != 0)
+			{
+				BenchmarkAnimCycles.fetch_add(FPlatformTime::Cycles64() - StartCycles, std::memory_order_relaxed);
+			}
+		}
+
+		uint64 StartCycles;
+	};
+}
+
+/** Count one ground trace for "stat SmartCatAI" and the benchmark (a single statement, safe anywhere) */
+#define SMARTCATAI_COUNT_TRACE() \
+	do \
+	{ \
+		INC_DWORD_STAT(STAT_SmartCatAI_NumTraces); \
+		if (SmartCatAIStats::bCollectBenchmarkCounters.load(std::memory_order_relaxed)) \
+		{ \
+			SmartCatAIStats::BenchmarkNumTraces.fetch_add(1, std::memory_order_relaxed); \
+		} \
+	} while (0)
@@ -3,11 +3,70 @@
 #include "SmartCatAnimInstance.h"
 #include "SmartCatAICharacter.h"
 #include "QuadrupedGaitCalculator.h"
+#include "SmartCatGaitSubsystem.h"
+#include "SmartCatAIStats.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "DrawDebugHelpers.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "SmartCatTraceFile.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+namespace SmartCatAnimInstance
+{
+	/** Next stagger slot handed out to an anim instance (game thread only) */
+	static uint32 NextIKStaggerIndex = 0;
+
+	/** SmartCat.IK.DumpFlightRecorder [Reason]: dump every live cat's IK flight recorder */
+	static FAutoConsoleCommand DumpFlightRecorderCommand(
+		TEXT("SmartCat.IK.DumpFlightRecorder"),
+		TEXT("Write the IK flight recorder of every cat to Saved/SmartCatIK/. Optional argument: reason text."),
+		FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+		{
+			const FString Reason = Args.Num() > 0 ? FString::Join(Args, TEXT(" ")) : TEXT("Console command");
+			for (TObjectIterator<USmartCatAnimInstance> It; It; ++It)
+			{
+				USmartCatAnimInstance* AnimInstance = *It;
+				UWorld* World = AnimInstance->GetWorld();
+				if (AnimInstance->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject) || !World || !World->IsGameWorld())
+				{
+					continue;
+				}
+				AnimInstance->DumpIKFlightRecorder(Reason);
+			}
+		}));
+
+	/** Point on the plane through PlanePoint with PlaneNormal, directly below/above Location */
+	static FVector ProjectOntoGroundPlane(const FVector& PlanePoint, const FVector& PlaneNormal, const FVector& Location)
+	{
+		FVector Result = Location;
+		if (PlaneNormal.Z > UE_KINDA_SMALL_NUMBER)
+		{
+			const FVector Delta = Location - PlanePoint;
+			Result.Z = PlanePoint.Z - (PlaneNormal.X * Delta.X + PlaneNormal.Y * Delta.Y) / PlaneNormal.Z;
+		}
+		return Result;
+	}
+
+	/** Speeds visited by a gait sweep (accumulated the same way as the original serial loop) */
+	static TArray<float> GetSweepSpeeds(float MinSpeed, float MaxSpeed, float SpeedStep)
+	{
+		TArray<float> Speeds;
+		for (float Speed = MinSpeed; Speed <= MaxSpeed; Speed += SpeedStep)
+		{
+			Speeds.Add(Speed);
+		}
+		return Speeds;
+	}
+
+	/** Rough upper bound on one CSV row of the gait sweep, used to preallocate the per-speed buffers */
+	static constexpr int32 GaitCSVRowReserve = 192;
+}
 
 USmartCatAnimInstance::USmartCatAnimInstance()
 	: CatCharacter(nullptr)
@@ -64,10 +123,27 @@ void USmartCatAnimInstance::NativeInitializeAnimation()
 	Super::NativeInitializeAnimation();
 
 	CatCharacter = Cast<ASmartCatAICharacter>(TryGetPawnOwner());
+
+	IKStaggerIndex = SmartCatAnimInstance::NextIKStaggerIndex++;
+
+	if (bEnableIKFlightRecorder)
+	{
+		IKFlightRecorder.Initialize(FMath::CeilToInt(FlightRecorderSeconds * FlightRecorderFrameRate));
+	}
+
+	// Resolve bone names to indices once; GatherIKInputs re-resolves if the mesh asset changes
+	CachedMesh = GetSkelMeshComponent();
+	if (CachedMesh)
+	{
+		ResolveBoneIndices();
+	}
 }
 
 void USmartCatAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 {
+	SMARTCATAI_SCOPE_CYCLE_COUNTER(STAT_SmartCatAI_AnimUpdate);
+	SmartCatAIStats::FBenchmarkAnimScope BenchmarkAnimScope;
+
 	Super::NativeUpdateAnimation(DeltaSeconds);
 
 	if (!CatCharacter)
@@ -79,9 +155,56 @@ void USmartCatAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 		}
 	}
 
+	INC_DWORD_STAT(STAT_SmartCatAI_NumActiveCats);
+
+	// Game thread: read character, movement component, mesh and world.
+	// Everything else happens in NativeThreadSafeUpdateAnimation.
 	UpdateMovementState(DeltaSeconds);
+	GatherIKInputs();
+	SyncGaitSlot(DeltaSeconds);
+
+#if !UE_BUILD_SHIPPING
+	// Anomaly raised by last frame's worker update
+	if (const uint8 Anomalies = PendingFlightRecorderAnomalies.exchange(0))
+	{
+		DumpIKFlightRecorder(FString::Printf(TEXT("Anomaly flags 0x%02x"), Anomalies));
+	}
+#endif
+}
+
+void USmartCatAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
+{
+	SMARTCATAI_SCOPE_CYCLE_COUNTER(STAT_SmartCatAI_AnimUpdateWorker);
+	SmartCatAIStats::FBenchmarkAnimScope BenchmarkAnimScope;
+
+	Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
+
+	if (!CatCharacter)
+	{
+		return;
+	}
+
+	// Worker thread safe: only uses data gathered in NativeUpdateAnimation
 	UpdateGait(DeltaSeconds);
 	UpdateIKTargets(DeltaSeconds);
+	RecordIKFlightFrame(DeltaSeconds);
+}
+
+void USmartCatAnimInstance::NativeUninitializeAnimation()
+{
+	if (bIsRecordingDebug)
+	{
+		StopRuntimeDebugRecording();
+	}
+
+	if (USmartCatGaitSubsystem* Subsystem = GaitSubsystem.Get())
+	{
+		Subsystem->UnregisterCat(GaitSlot);
+	}
+	GaitSubsystem.Reset();
+	GaitSlot = INDEX_NONE;
+
+	Super::NativeUninitializeAnimation();
 }
 
 void USmartCatAnimInstance::UpdateMovementState(float DeltaSeconds)
@@ -103,30 +226,323 @@ void USmartCatAnimInstance::UpdateMovementState(float DeltaSeconds)
 	}
 }
 
-void USmartCatAnimInstance::UpdateGait(float DeltaSeconds)
+void USmartCatAnimInstance::GatherIKInputs()
 {
-	// Update gait state using the shared calculator
-	UQuadrupedGaitCalculator::UpdateGaitState(GaitState, GaitConfig, Velocity, DeltaSeconds);
-	CurrentGait = GaitState.DetectedGait;
-}
+	FCatAnimGameThreadData& Data = GameThreadData;
 
-void USmartCatAnimInstance::UpdateIKTargets(float DeltaSeconds)
-{
 	// Cache mesh reference
 	if (!CachedMesh)
 	{
 		CachedMesh = GetSkelMeshComponent();
-		if (!CachedMesh)
+	}
+
+	UpdateIKLOD();
+
+	// Fetch every bone we need once for this frame (nothing reads them with IK LOD'd out)
+	Data.Bones.bValid = false;
+	if (CachedMesh && CurrentIKLOD != ECatIKLOD::Off)
+	{
+		CaptureBoneSnapshot(Data.Bones);
+	}
+
+	// Resolve mode and enable state here so action changes made on the game thread
+	// (TriggerAction/ClearAction) never race the worker update
+	Data.EffectiveIKMode = GetEffectiveIKMode();
+	if (CurrentIKLOD == ECatIKLOD::SlopeOnly && Data.EffectiveIKMode != ECatIKMode::Disabled)
+	{
+		Data.EffectiveIKMode = ECatIKMode::SlopeAdaptation;
+	}
+	Data.bIKEnabled = CachedMesh && ShouldEnableIK() && (Data.EffectiveIKMode != ECatIKMode::Disabled)
+		&& CurrentIKLOD != ECatIKLOD::Off;
+
+	if (!Data.bIKEnabled)
+	{
+		// Pending traces would be stale by the time IK comes back on
+		ResetAsyncFootTraces();
+		bHasSolvedFootTraces = false;
+		return;
+	}
+
+	// Reduced rate: skip tracing on off frames unless there is nothing to carry over yet
+	const uint64 FrameNumber = GFrameCounter;
+	const bool bFullRateAsync = bUseAsyncFootTraces && CurrentIKLOD == ECatIKLOD::Full;
+	if (bHasSolvedFootTraces && LastSolvedIKLOD == CurrentIKLOD && !IsIKSolveFrame(FrameNumber))
+	{
+		ExtrapolateFootTraces();
+
+		// Async results only survive one frame, so queue them just before the next solve
+		if (bFullRateAsync && IsIKSolveFrame(FrameNumber + 1))
+		{
+			SubmitAsyncFootTraces();
+		}
+		return;
+	}
+
+	// Mid range: one body trace stands in for the four paw traces
+	if (CurrentIKLOD == ECatIKLOD::SlopeOnly)
+	{
+		ResetAsyncFootTraces();
+		TraceBodyToGround();
+		StoreSolvedFootTraces();
+		return;
+	}
+
+	// Pick up last frame's async paw traces before sampling
+	if (bUseAsyncFootTraces)
+	{
+		CollectAsyncFootTraces();
+	}
+
+	if (bUseGroundSampleCache)
+	{
+		// Samples taken on a different base are meaningless once the cat steps off it
+		const UPrimitiveComponent* MovementBase = CatCharacter->GetMovementBase();
+		if (GroundSampleBase.Get() != MovementBase)
+		{
+			InvalidateGroundSamples();
+			GroundSampleBase = MovementBase;
+		}
+		GroundSampleNow = CatCharacter->GetWorld()->GetTimeSeconds();
+	}
+
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+	{
+		FCatFootTraceResult& Trace = Data.FootTraces[Leg];
+		const FVector PawLocation = Data.Bones.Paws[Leg].GetLocation();
+
+		// Paw hasn't moved: reuse the last hit instead of tracing
+		if (bUseGroundSampleCache && LookupGroundSample(Leg, PawLocation, GroundCacheMoveThreshold, Trace))
+		{
+			continue;
+		}
+
+		Trace.bHit = TraceFootToGround(Leg, PawLocation, Trace.HitLocation, Trace.HitNormal);
+		Trace.bValid = true;
+
+		if (bUseGroundSampleCache)
+		{
+			StoreGroundSample(Leg, PawLocation, Trace);
+		}
+	}
+
+	StoreSolvedFootTraces();
+
+	// Queue next frame's paw traces as one batch (only if next frame traces)
+	if (bFullRateAsync && IsIKSolveFrame(FrameNumber + 1))
+	{
+		SubmitAsyncFootTraces();
+	}
+}
+
+void USmartCatAnimInstance::SyncGaitSlot(float DeltaSeconds)
+{
+	FCatAnimGameThreadData& Data = GameThreadData;
+	Data.bBatchedGait = false;
+
+	USmartCatGaitSubsystem* Subsystem = GaitSubsystem.Get();
+	if (!bUseGaitSubsystem)
+	{
+		// Switched off at runtime: give the slot back
+		if (Subsystem)
+		{
+			Subsystem->UnregisterCat(GaitSlot);
+			GaitSubsystem.Reset();
+			GaitSlot = INDEX_NONE;
+		}
+		return;
+	}
+
+	if (!Subsystem)
+	{
+		UWorld* World = GetWorld();
+		Subsystem = World ? World->GetSubsystem<USmartCatGaitSubsystem>() : nullptr;
+		if (!Subsystem)
 		{
 			return;
 		}
+		GaitSubsystem = Subsystem;
+		GaitSlot = Subsystem->RegisterCat();
+	}
+
+	// Only Full Procedural reads the batched leg outputs; other modes update gait locally
+	if (!Data.bIKEnabled || Data.EffectiveIKMode != ECatIKMode::FullProcedural)
+	{
+		return;
+	}
+
+	// The batch advances the newest state this instance has (last batch's result, or its own when
+	// it just switched over) by its own delta, so dropping in and out of the batch keeps the phase
+	Data.bBatchedGait = Subsystem->GetCatOutput(GaitSlot, Data.BatchedGaitState, Data.BatchedGaitLegs);
+	Subsystem->SetCatInput(GaitSlot, Data.bBatchedGait ? Data.BatchedGaitState : GaitState, GaitConfig, Velocity, MoveDirection, DeltaSeconds);
+}
+
+void USmartCatAnimInstance::UpdateIKLOD()
+{
+	if (!bEnableIKLOD)
+	{
+		CurrentIKLOD = ECatIKLOD::Full;
+		return;
+	}
+
+	const float Distance = GetNearestViewerDistance();
+
+	// No local viewer (e.g. dedicated server): leave IK as configured
+	if (Distance == MAX_flt)
+	{
+		CurrentIKLOD = ECatIKLOD::Full;
+		return;
+	}
+
+	// Each threshold is pushed out while we are inside it and pulled in while outside,
+	// so a cat sitting on a boundary doesn't flip levels every frame
+	auto IsWithin = [this, Distance](float Threshold, bool bCurrentlyWithin)
+	{
+		return Distance < (bCurrentlyWithin ? Threshold + IKLODHysteresis : Threshold - IKLODHysteresis);
+	};
+
+	ECatIKLOD NewLOD = ECatIKLOD::Off;
+	if (IsWithin(IKLODFullDistance, CurrentIKLOD == ECatIKLOD::Full))
+	{
+		NewLOD = ECatIKLOD::Full;
+	}
+	else if (IsWithin(IKLODSlopeDistance, CurrentIKLOD != ECatIKLOD::Off))
+	{
+		NewLOD = ECatIKLOD::SlopeOnly;
+	}
+
+	if (CachedMesh)
+	{
+		// Screen-size proxies: off screen means nothing to adapt, a coarse mesh LOD means small on screen
+		if (!CachedMesh->WasRecentlyRendered(IKLODOffscreenTime))
+		{
+			NewLOD = ECatIKLOD::Off;
+		}
+		else if (NewLOD == ECatIKLOD::Full && CachedMesh->GetPredictedLODLevel() >= IKLODSlopeOnlyMeshLOD)
+		{
+			NewLOD = ECatIKLOD::SlopeOnly;
+		}
+	}
+
+	CurrentIKLOD = NewLOD;
+}
+
+float USmartCatAnimInstance::GetNearestViewerDistance() const
+{
+	UWorld* World = CatCharacter ? CatCharacter->GetWorld() : nullptr;
+	if (!World)
+	{
+		return MAX_flt;
+	}
+
+	const FVector CatLocation = CatCharacter->GetActorLocation();
+	float NearestDistSq = MAX_flt;
+
+	// Camera and player pawn both count: the player can be near a cat the camera is far from
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (!PC || !PC->IsLocalController())
+		{
+			continue;
+		}
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		NearestDistSq = FMath::Min(NearestDistSq, static_cast<float>(FVector::DistSquared(CatLocation, ViewLocation)));
+
+		if (const APawn* Pawn = PC->GetPawn())
+		{
+			NearestDistSq = FMath::Min(NearestDistSq, static_cast<float>(FVector::DistSquared(CatLocation, Pawn->GetActorLocation())));
+		}
+	}
+
+	return NearestDistSq == MAX_flt ? MAX_flt : FMath::Sqrt(NearestDistSq);
+}
+
+void USmartCatAnimInstance::TraceBodyToGround()
+{
+	FCatAnimGameThreadData& Data = GameThreadData;
+
+	FVector BodyHit;
+	FVector BodyNormal;
+	const FVector PelvisLocation = Data.Bones.Pelvis.GetLocation();
+	const bool bHit = TraceFootToGroundSync(PelvisLocation, BodyHit, BodyNormal) && BodyNormal.Z > UE_KINDA_SMALL_NUMBER;
+
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+	{
+		FCatFootTraceResult& Trace = Data.FootTraces[Leg];
+		const FVector PawLocation = Data.Bones.Paws[Leg].GetLocation();
+
+		// Treat the ground as the plane through the body hit and read its height under each paw,
+		// so the slope math sees the same inputs it would get from four paw traces on a flat slope
+		Trace.bHit = bHit;
+		Trace.bValid = true;
+		Trace.HitNormal = bHit ? BodyNormal : FVector::UpVector;
+		Trace.HitLocation = bHit ? SmartCatAnimInstance::ProjectOntoGroundPlane(BodyHit, BodyNormal, PawLocation) : PawLocation;
+	}
+}
+
+bool USmartCatAnimInstance::IsIKSolveFrame(uint64 FrameNumber) const
+{
+	const int32 Interval = FMath::Max(1, CurrentIKLOD == ECatIKLOD::SlopeOnly ? IKSlopeOnlyUpdateInterval : IKUpdateInterval);
+	return Interval == 1 || (FrameNumber + IKStaggerIndex) % Interval == 0;
+}
+
+void USmartCatAnimInstance::StoreSolvedFootTraces()
+{
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+	{
+		LastSolvedFootTraces[Leg] = GameThreadData.FootTraces[Leg];
+	}
+	bHasSolvedFootTraces = true;
+	LastSolvedIKLOD = CurrentIKLOD;
+}
+
+void USmartCatAnimInstance::ExtrapolateFootTraces()
+{
+	FCatAnimGameThreadData& Data = GameThreadData;
+
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+	{
+		const FCatFootTraceResult& Solved = LastSolvedFootTraces[Leg];
+		FCatFootTraceResult& Trace = Data.FootTraces[Leg];
+		const FVector PawLocation = Data.Bones.Paws[Leg].GetLocation();
+
+		// Slide the hit along its ground plane so a moving paw keeps a target under it (no foot sliding);
+		// the worker's FInterpTo smoothing absorbs the correction when the next real trace lands
+		Trace = Solved;
+		Trace.HitLocation = Solved.bHit
+			? SmartCatAnimInstance::ProjectOntoGroundPlane(Solved.HitLocation, Solved.HitNormal, PawLocation)
+			: PawLocation;
+	}
+}
+
+void USmartCatAnimInstance::UpdateGait(float DeltaSeconds)
+{
+	SMARTCATAI_SCOPE_CYCLE_COUNTER(STAT_SmartCatAI_GaitMath);
+
+	if (GameThreadData.bBatchedGait)
+	{
+		// Already evaluated by the batch subsystem
+		GaitState = GameThreadData.BatchedGaitState;
 	}
+	else
+	{
+		// Update gait state using the shared calculator
+		UQuadrupedGaitCalculator::UpdateGaitState(GaitState, GaitConfig, Velocity, DeltaSeconds);
+	}
+	CurrentGait = GaitState.DetectedGait;
+}
 
-	// Get effective IK mode (may be overridden by state)
-	ECatIKMode EffectiveMode = GetEffectiveIKMode();
+void USmartCatAnimInstance::UpdateIKTargets(float DeltaSeconds)
+{
+	// Mode and enable state were resolved on the game thread
+	const ECatIKMode EffectiveMode = GameThreadData.EffectiveIKMode;
+	bIKEnabled = GameThreadData.bIKEnabled;
 
-	// Determine if IK should be active
-	bIKEnabled = ShouldEnableIK() && (EffectiveMode != ECatIKMode::Disabled);
+	// Blend from the alphas as published (or as set from Blueprint / the details panel)
+	SeedLegAlphas();
 
 	// Target alpha based on IK enable state
 	const float TargetAlpha = bIKEnabled ? 1.0f : 0.0f;
@@ -135,24 +551,26 @@ void USmartCatAnimInstance::UpdateIKTargets(float DeltaSeconds)
 	{
 		// Smoothly disable IK
 		IKAlpha = FMath::FInterpTo(IKAlpha, 0.0f, DeltaSeconds, IKInterpSpeed);
-		IKAlpha_FrontLeft = IKAlpha;
-		IKAlpha_FrontRight = IKAlpha;
-		IKAlpha_BackLeft = IKAlpha;
-		IKAlpha_BackRight = IKAlpha;
+		for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+		{
+			LegIK.IKAlpha[Leg] = IKAlpha;
+		}
 		PelvisAlpha = IKAlpha;
 
 		// Reset terrain adaptation data when IK is disabled
 		if (IKAlpha < 0.01f)
 		{
-			FootOffset_FL = 0.0f;
-			FootOffset_FR = 0.0f;
-			FootOffset_BL = 0.0f;
-			FootOffset_BR = 0.0f;
+			for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+			{
+				LegIK.FootOffset[Leg] = 0.0f;
+			}
 			PelvisOffsetZ = 0.0f;
 			PelvisPitch = 0.0f;
 			PelvisRoll = 0.0f;
 			PelvisRotation = FRotator::ZeroRotator;
 		}
+
+		PublishLegMirrors();
 		return;
 	}
 
@@ -178,89 +596,54 @@ void USmartCatAnimInstance::UpdateIKTargets(float DeltaSeconds)
 		UpdateProceduralIK(DeltaSeconds);
 		// Procedural mode uses global alpha for all
 		IKAlpha = FMath::FInterpTo(IKAlpha, TargetAlpha, DeltaSeconds, IKInterpSpeed);
-		IKAlpha_FrontLeft = IKAlpha;
-		IKAlpha_FrontRight = IKAlpha;
-		IKAlpha_BackLeft = IKAlpha;
-		IKAlpha_BackRight = IKAlpha;
+		for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+		{
+			LegIK.IKAlpha[Leg] = IKAlpha;
+		}
 		PelvisAlpha = IKAlpha;
 		break;
 
 	default:
 		break;
 	}
+
+	PublishLegMirrors();
 }
 
 void USmartCatAnimInstance::UpdateSlopeAdaptationIK(float DeltaSeconds)
 {
+	SMARTCATAI_SCOPE_CYCLE_COUNTER(STAT_SmartCatAI_IKSlopeAdaptation);
+
 	// Slope Adaptation Mode:
 	// 1. Sample ground height at each paw location
 	// 2. Calculate slope pitch (front/back difference) and roll (left/right difference)
 	// 3. Output rotation for mesh/root bone to match terrain slope
 	// 4. Calculate residual offsets for optional per-foot IK fine-tuning
 
-	FVector HitLocation, HitNormal;
-
-	// Get bone positions
-	FVector BoneFL = CachedMesh->GetSocketLocation(BoneName_FrontLeft);
-	FVector BoneFR = CachedMesh->GetSocketLocation(BoneName_FrontRight);
-	FVector BoneBL = CachedMesh->GetSocketLocation(BoneName_BackLeft);
-	FVector BoneBR = CachedMesh->GetSocketLocation(BoneName_BackRight);
+	const FCatFootTraceResult* Traces = GameThreadData.FootTraces;
+	const FTransform* Paws = GameThreadData.Bones.Paws;
 
 	// Sample ground Z at each paw location
-	float RawGroundZ_FL = 0.0f, RawGroundZ_FR = 0.0f, RawGroundZ_BL = 0.0f, RawGroundZ_BR = 0.0f;
-	bool bValidFL = false, bValidFR = false, bValidBL = false, bValidBR = false;
-
-	if (TraceFootToGround(BoneName_FrontLeft, HitLocation, HitNormal))
+	float RawGroundZ[EQuadrupedLeg::Num];
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
 	{
-		RawGroundZ_FL = HitLocation.Z;
-		bValidFL = true;
-		GroundNormal_FL = HitNormal;
-	}
-
-	if (TraceFootToGround(BoneName_FrontRight, HitLocation, HitNormal))
-	{
-		RawGroundZ_FR = HitLocation.Z;
-		bValidFR = true;
-		GroundNormal_FR = HitNormal;
-	}
-
-	if (TraceFootToGround(BoneName_BackLeft, HitLocation, HitNormal))
-	{
-		RawGroundZ_BL = HitLocation.Z;
-		bValidBL = true;
-		GroundNormal_BL = HitNormal;
+		RawGroundZ[Leg] = Traces[Leg].bHit ? Traces[Leg].HitLocation.Z : 0.0f;
+		if (Traces[Leg].bHit)
+		{
+			LegIK.GroundNormal[Leg] = Traces[Leg].HitNormal;
+		}
 	}
 
-	if (TraceFootToGround(BoneName_BackRight, HitLocation, HitNormal))
+	// Interpolate ground Z values for smooth transitions
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
 	{
-		RawGroundZ_BR = HitLocation.Z;
-		bValidBR = true;
-		GroundNormal_BR = HitNormal;
+		LegIK.GroundZ[Leg] = FMath::FInterpTo(LegIK.GroundZ[Leg], RawGroundZ[Leg], DeltaSeconds, SlopeInterpSpeed);
 	}
 
-	// Interpolate ground Z values for smooth transitions
-	GroundZ_FL = FMath::FInterpTo(GroundZ_FL, RawGroundZ_FL, DeltaSeconds, SlopeInterpSpeed);
-	GroundZ_FR = FMath::FInterpTo(GroundZ_FR, RawGroundZ_FR, DeltaSeconds, SlopeInterpSpeed);
-	GroundZ_BL = FMath::FInterpTo(GroundZ_BL, RawGroundZ_BL, DeltaSeconds, SlopeInterpSpeed);
-	GroundZ_BR = FMath::FInterpTo(GroundZ_BR, RawGroundZ_BR, DeltaSeconds, SlopeInterpSpeed);
-
-	// Calculate average ground heights for slope calculation
-	float FrontAvgGround = (GroundZ_FL + GroundZ_FR) * 0.5f;
-	float BackAvgGround = (GroundZ_BL + GroundZ_BR) * 0.5f;
-	float LeftAvgGround = (GroundZ_FL + GroundZ_BL) * 0.5f;
-	float RightAvgGround = (GroundZ_FR + GroundZ_BR) * 0.5f;
-
-	AverageGroundZ = (GroundZ_FL + GroundZ_FR + GroundZ_BL + GroundZ_BR) * 0.25f;
-
-	// Calculate slope pitch: positive = climbing (nose up), negative = descending (nose down)
-	float SlopeHeightDiff = FrontAvgGround - BackAvgGround;
-	float RawSlopePitch = FMath::RadiansToDegrees(FMath::Atan2(SlopeHeightDiff, BodyLength));
-	RawSlopePitch = FMath::Clamp(RawSlopePitch, -MaxSlopePitch, MaxSlopePitch);
-
-	// Calculate slope roll: positive = left side higher, negative = right side higher
-	float RollHeightDiff = LeftAvgGround - RightAvgGround;
-	float RawSlopeRoll = FMath::RadiansToDegrees(FMath::Atan2(RollHeightDiff, BodyWidth));
-	RawSlopeRoll = FMath::Clamp(RawSlopeRoll, -MaxSlopeRoll, MaxSlopeRoll);
+	// Slope pitch/roll from the average front/back and left/right ground heights
+	float RawSlopePitch;
+	float RawSlopeRoll;
+	ComputeSlopeAngles(LegIK.GroundZ, BodyLength, BodyWidth, MaxSlopePitch, MaxSlopeRoll, AverageGroundZ, RawSlopePitch, RawSlopeRoll);
 
 	// Interpolate slope angles for smooth rotation
 	SlopePitch = FMath::FInterpTo(SlopePitch, RawSlopePitch, DeltaSeconds, SlopeInterpSpeed);
@@ -269,51 +652,23 @@ void USmartCatAnimInstance::UpdateSlopeAdaptationIK(float DeltaSeconds)
 	// Build slope rotation (pitch and roll only, no yaw)
 	SlopeRotation = FRotator(SlopePitch, 0.0f, SlopeRoll);
 
-	// Calculate expected paw heights after slope rotation is applied
-	// This uses simple trigonometry to estimate where paws would be after mesh rotates
-	float PitchRad = FMath::DegreesToRadians(SlopePitch);
-	float RollRad = FMath::DegreesToRadians(SlopeRoll);
+	// Residual offsets: difference between actual ground and expected paw position after rotation.
+	// These are for optional per-foot IK fine-tuning on uneven terrain
+	float Residuals[EQuadrupedLeg::Num];
+	ComputeSlopeResiduals(LegIK.GroundZ, AverageGroundZ, SlopePitch, SlopeRoll, BodyLength, BodyWidth, FootHeight, MaxIKOffset, Residuals);
 
-	// Approximate Z adjustment from rotation for each corner
-	// Front paws move up/down based on pitch, left/right paws based on roll
-	float HalfLength = BodyLength * 0.5f;
-	float HalfWidth = BodyWidth * 0.5f;
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+	{
+		const float Residual = Residuals[Leg];
 
-	float RotationAdjust_FL = HalfLength * FMath::Sin(PitchRad) + HalfWidth * FMath::Sin(RollRad);
-	float RotationAdjust_FR = HalfLength * FMath::Sin(PitchRad) - HalfWidth * FMath::Sin(RollRad);
-	float RotationAdjust_BL = -HalfLength * FMath::Sin(PitchRad) + HalfWidth * FMath::Sin(RollRad);
-	float RotationAdjust_BR = -HalfLength * FMath::Sin(PitchRad) - HalfWidth * FMath::Sin(RollRad);
+		LegIK.ResidualOffset[Leg] = Residual;
 
-	// Calculate residual offsets (difference between actual ground and expected position after rotation)
-	// These are for optional per-foot IK fine-tuning on uneven terrain
-	float ExpectedZ_FL = AverageGroundZ + RotationAdjust_FL + FootHeight;
-	float ExpectedZ_FR = AverageGroundZ + RotationAdjust_FR + FootHeight;
-	float ExpectedZ_BL = AverageGroundZ + RotationAdjust_BL + FootHeight;
-	float ExpectedZ_BR = AverageGroundZ + RotationAdjust_BR + FootHeight;
-
-	ResidualOffset_FL = (GroundZ_FL + FootHeight) - ExpectedZ_FL;
-	ResidualOffset_FR = (GroundZ_FR + FootHeight) - ExpectedZ_FR;
-	ResidualOffset_BL = (GroundZ_BL + FootHeight) - ExpectedZ_BL;
-	ResidualOffset_BR = (GroundZ_BR + FootHeight) - ExpectedZ_BR;
-
-	// Clamp residual offsets
-	ResidualOffset_FL = FMath::Clamp(ResidualOffset_FL, -MaxIKOffset, MaxIKOffset);
-	ResidualOffset_FR = FMath::Clamp(ResidualOffset_FR, -MaxIKOffset, MaxIKOffset);
-	ResidualOffset_BL = FMath::Clamp(ResidualOffset_BL, -MaxIKOffset, MaxIKOffset);
-	ResidualOffset_BR = FMath::Clamp(ResidualOffset_BR, -MaxIKOffset, MaxIKOffset);
-
-	// Set per-foot IK alphas based on residual offset magnitude
-	// Only apply foot IK if residual is significant (uneven terrain)
-	IKAlpha_FrontLeft = (FMath::Abs(ResidualOffset_FL) > ResidualIKThreshold) ? 1.0f : 0.0f;
-	IKAlpha_FrontRight = (FMath::Abs(ResidualOffset_FR) > ResidualIKThreshold) ? 1.0f : 0.0f;
-	IKAlpha_BackLeft = (FMath::Abs(ResidualOffset_BL) > ResidualIKThreshold) ? 1.0f : 0.0f;
-	IKAlpha_BackRight = (FMath::Abs(ResidualOffset_BR) > ResidualIKThreshold) ? 1.0f : 0.0f;
-
-	// Also populate the standard foot offsets for compatibility
-	FootOffset_FL = ResidualOffset_FL;
-	FootOffset_FR = ResidualOffset_FR;
-	FootOffset_BL = ResidualOffset_BL;
-	FootOffset_BR = ResidualOffset_BR;
+		// Only apply foot IK if residual is significant (uneven terrain)
+		LegIK.IKAlpha[Leg] = (FMath::Abs(Residual) > ResidualIKThreshold) ? 1.0f : 0.0f;
+
+		// Also populate the standard foot offsets for compatibility
+		LegIK.FootOffset[Leg] = Residual;
+	}
 
 	// Update pelvis data (use slope rotation)
 	PelvisPitch = SlopePitch;
@@ -321,151 +676,107 @@ void USmartCatAnimInstance::UpdateSlopeAdaptationIK(float DeltaSeconds)
 	PelvisRotation = SlopeRotation;
 	PelvisOffsetZ = 0.0f; // Height adjustment handled by rotation, not offset
 
-	// Calculate foot rotations from ground normals
-	FootRotation_FL = CalculateFootRotationFromNormal(GroundNormal_FL);
-	FootRotation_FR = CalculateFootRotationFromNormal(GroundNormal_FR);
-	FootRotation_BL = CalculateFootRotationFromNormal(GroundNormal_BL);
-	FootRotation_BR = CalculateFootRotationFromNormal(GroundNormal_BR);
-
-	// Populate world-space IK targets (for residual foot IK if needed)
-	IKFootTarget_FrontLeft = BoneFL + FVector(0, 0, ResidualOffset_FL);
-	IKFootTarget_FrontRight = BoneFR + FVector(0, 0, ResidualOffset_FR);
-	IKFootTarget_BackLeft = BoneBL + FVector(0, 0, ResidualOffset_BL);
-	IKFootTarget_BackRight = BoneBR + FVector(0, 0, ResidualOffset_BR);
-
-	// Build transforms
-	IKFootTransform_FrontLeft = FTransform(FootRotation_FL.Quaternion(), IKFootTarget_FrontLeft);
-	IKFootTransform_FrontRight = FTransform(FootRotation_FR.Quaternion(), IKFootTarget_FrontRight);
-	IKFootTransform_BackLeft = FTransform(FootRotation_BL.Quaternion(), IKFootTarget_BackLeft);
-	IKFootTransform_BackRight = FTransform(FootRotation_BR.Quaternion(), IKFootTarget_BackRight);
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+	{
+		// Calculate foot rotations from ground normals
+		LegIK.FootRotation[Leg] = CalculateFootRotationFromNormal(LegIK.GroundNormal[Leg]);
+
+		// Populate world-space IK targets (for residual foot IK if needed)
+		LegIK.IKFootTarget[Leg] = Paws[Leg].GetLocation() + FVector(0, 0, LegIK.ResidualOffset[Leg]);
+		LegIK.IKFootTransform[Leg] = FTransform(LegIK.FootRotation[Leg].Quaternion(), LegIK.IKFootTarget[Leg]);
+	}
 }
 
-void USmartCatAnimInstance::UpdateTerrainAdaptationIK(float DeltaSeconds)
+void USmartCatAnimInstance::ComputeSlopeAngles(const float (&GroundZ)[EQuadrupedLeg::Num], float InBodyLength, float InBodyWidth,
+	float MaxPitch, float MaxRoll, float& OutAverageGroundZ, float& OutPitch, float& OutRoll)
 {
-	// Terrain Adaptation Mode (Height-Based):
-	// - Detect swing/stance by measuring paw height above ground
-	// - If paw is above ground threshold → swing phase → alpha = 0 (let animation show)
-	// - If paw is at/near ground → stance phase → alpha = 1 (apply IK to plant)
+	// Calculate average ground heights for slope calculation
+	const float FrontAvgGround = (GroundZ[EQuadrupedLeg::FrontLeft] + GroundZ[EQuadrupedLeg::FrontRight]) * 0.5f;
+	const float BackAvgGround = (GroundZ[EQuadrupedLeg::BackLeft] + GroundZ[EQuadrupedLeg::BackRight]) * 0.5f;
+	const float LeftAvgGround = (GroundZ[EQuadrupedLeg::FrontLeft] + GroundZ[EQuadrupedLeg::BackLeft]) * 0.5f;
+	const float RightAvgGround = (GroundZ[EQuadrupedLeg::FrontRight] + GroundZ[EQuadrupedLeg::BackRight]) * 0.5f;
 
-	FVector HitLocation, HitNormal;
+	OutAverageGroundZ = (FrontAvgGround + BackAvgGround) * 0.5f;
 
-	// Get bone positions (previous frame's output, but with correct alpha this reflects animation)
-	FVector BoneFL = CachedMesh->GetSocketLocation(BoneName_FrontLeft);
-	FVector BoneFR = CachedMesh->GetSocketLocation(BoneName_FrontRight);
-	FVector BoneBL = CachedMesh->GetSocketLocation(BoneName_BackLeft);
-	FVector BoneBR = CachedMesh->GetSocketLocation(BoneName_BackRight);
+	// Calculate slope pitch: positive = climbing (nose up), negative = descending (nose down)
+	const float SlopeHeightDiff = FrontAvgGround - BackAvgGround;
+	OutPitch = FMath::Clamp(FMath::RadiansToDegrees(FMath::Atan2(SlopeHeightDiff, InBodyLength)), -MaxPitch, MaxPitch);
 
-	// Trace and calculate height above ground for each foot
-	float HeightAboveGround_FL = 0.0f;
-	float HeightAboveGround_FR = 0.0f;
-	float HeightAboveGround_BL = 0.0f;
-	float HeightAboveGround_BR = 0.0f;
+	// Calculate slope roll: positive = left side higher, negative = right side higher
+	const float RollHeightDiff = LeftAvgGround - RightAvgGround;
+	OutRoll = FMath::Clamp(FMath::RadiansToDegrees(FMath::Atan2(RollHeightDiff, InBodyWidth)), -MaxRoll, MaxRoll);
+}
 
-	// Front Left
-	if (TraceFootToGround(BoneName_FrontLeft, HitLocation, HitNormal))
-	{
-		float GroundZ = HitLocation.Z + FootHeight;
-		HeightAboveGround_FL = BoneFL.Z - GroundZ;
-		RawFootOffset_FL = GroundZ - BoneFL.Z;  // Offset to reach ground
-		RawFootOffset_FL = FMath::Clamp(RawFootOffset_FL, -MaxIKOffset, MaxIKOffset);
-		GroundNormal_FL = HitNormal;
-	}
-	else
-	{
-		RawFootOffset_FL = 0.0f;
-		GroundNormal_FL = FVector::UpVector;
-		HeightAboveGround_FL = 999.0f;  // No ground found, treat as airborne
-	}
+void USmartCatAnimInstance::ComputeSlopeResiduals(const float (&GroundZ)[EQuadrupedLeg::Num], float InAverageGroundZ, float Pitch, float Roll,
+	float InBodyLength, float InBodyWidth, float InFootHeight, float InMaxIKOffset, float (&OutResiduals)[EQuadrupedLeg::Num])
+{
+	// Approximate Z adjustment from rotation for each corner
+	// Front paws move up/down based on pitch, left/right paws based on roll
+	const float PitchAdjust = InBodyLength * 0.5f * FMath::Sin(FMath::DegreesToRadians(Pitch));
+	const float RollAdjust = InBodyWidth * 0.5f * FMath::Sin(FMath::DegreesToRadians(Roll));
 
-	// Front Right
-	if (TraceFootToGround(BoneName_FrontRight, HitLocation, HitNormal))
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
 	{
-		float GroundZ = HitLocation.Z + FootHeight;
-		HeightAboveGround_FR = BoneFR.Z - GroundZ;
-		RawFootOffset_FR = GroundZ - BoneFR.Z;
-		RawFootOffset_FR = FMath::Clamp(RawFootOffset_FR, -MaxIKOffset, MaxIKOffset);
-		GroundNormal_FR = HitNormal;
-	}
-	else
-	{
-		RawFootOffset_FR = 0.0f;
-		GroundNormal_FR = FVector::UpVector;
-		HeightAboveGround_FR = 999.0f;
+		const float RotationAdjust = LegFrontSign[Leg] * PitchAdjust + LegLeftSign[Leg] * RollAdjust;
+		const float ExpectedZ = InAverageGroundZ + RotationAdjust + InFootHeight;
+		OutResiduals[Leg] = FMath::Clamp((GroundZ[Leg] + InFootHeight) - ExpectedZ, -InMaxIKOffset, InMaxIKOffset);
 	}
+}
 
-	// Back Left
-	if (TraceFootToGround(BoneName_BackLeft, HitLocation, HitNormal))
-	{
-		float GroundZ = HitLocation.Z + FootHeight;
-		HeightAboveGround_BL = BoneBL.Z - GroundZ;
-		RawFootOffset_BL = GroundZ - BoneBL.Z;
-		RawFootOffset_BL = FMath::Clamp(RawFootOffset_BL, -MaxIKOffset, MaxIKOffset);
-		GroundNormal_BL = HitNormal;
-	}
-	else
+void USmartCatAnimInstance::UpdateTerrainAdaptationIK(float DeltaSeconds)
+{
+	SMARTCATAI_SCOPE_CYCLE_COUNTER(STAT_SmartCatAI_IKTerrainAdaptation);
+
+	// Terrain Adaptation Mode (Height-Based):
+	// - Detect swing/stance by measuring paw height above ground
+	// - If paw is above ground threshold → swing phase → alpha = 0 (let animation show)
+	// - If paw is at/near ground → stance phase → alpha = 1 (apply IK to plant)
+
+	const FCatFootTraceResult* Traces = GameThreadData.FootTraces;
+	const FTransform* Paws = GameThreadData.Bones.Paws;
+
+	// Bone Z (previous frame's output, but with correct alpha this reflects animation)
+	// and height above ground for each foot
+	float PawZ[EQuadrupedLeg::Num];
+	float HeightAboveGround[EQuadrupedLeg::Num];
+
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
 	{
-		RawFootOffset_BL = 0.0f;
-		GroundNormal_BL = FVector::UpVector;
-		HeightAboveGround_BL = 999.0f;
+		PawZ[Leg] = Paws[Leg].GetLocation().Z;
+
+		if (Traces[Leg].bHit)
+		{
+			const float FootGroundZ = Traces[Leg].HitLocation.Z + FootHeight;
+			HeightAboveGround[Leg] = PawZ[Leg] - FootGroundZ;
+			LegIK.RawFootOffset[Leg] = FMath::Clamp(FootGroundZ - PawZ[Leg], -MaxIKOffset, MaxIKOffset);  // Offset to reach ground
+			LegIK.GroundNormal[Leg] = Traces[Leg].HitNormal;
+		}
+		else
+		{
+			LegIK.RawFootOffset[Leg] = 0.0f;
+			LegIK.GroundNormal[Leg] = FVector::UpVector;
+			HeightAboveGround[Leg] = 999.0f;  // No ground found, treat as airborne
+		}
 	}
 
-	// Back Right
-	if (TraceFootToGround(BoneName_BackRight, HitLocation, HitNormal))
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
 	{
-		float GroundZ = HitLocation.Z + FootHeight;
-		HeightAboveGround_BR = BoneBR.Z - GroundZ;
-		RawFootOffset_BR = GroundZ - BoneBR.Z;
-		RawFootOffset_BR = FMath::Clamp(RawFootOffset_BR, -MaxIKOffset, MaxIKOffset);
-		GroundNormal_BR = HitNormal;
+		// Interpolate foot offsets for smooth IK
+		LegIK.FootOffset[Leg] = FMath::FInterpTo(LegIK.FootOffset[Leg], LegIK.RawFootOffset[Leg], DeltaSeconds, IKInterpSpeed);
+
+		// Determine alpha based on height above ground
+		// Above threshold = swing (alpha 0), at/below threshold = stance (alpha 1)
+		// Instant off during swing so animation foot lift shows,
+		// smooth blend on during stance to avoid popping
+		const bool bSwinging = HeightAboveGround[Leg] > SwingPhaseHeightThreshold;
+		LegIK.IKAlpha[Leg] = bSwinging ? 0.0f : FMath::FInterpTo(LegIK.IKAlpha[Leg], 1.0f, DeltaSeconds, FootIKBlendSpeed);
 	}
-	else
-	{
-		RawFootOffset_BR = 0.0f;
-		GroundNormal_BR = FVector::UpVector;
-		HeightAboveGround_BR = 999.0f;
-	}
-
-	// Determine alpha based on height above ground
-	// Above threshold = swing (alpha 0), at/below threshold = stance (alpha 1)
-	float TargetAlpha_FL = (HeightAboveGround_FL > SwingPhaseHeightThreshold) ? 0.0f : 1.0f;
-	float TargetAlpha_FR = (HeightAboveGround_FR > SwingPhaseHeightThreshold) ? 0.0f : 1.0f;
-	float TargetAlpha_BL = (HeightAboveGround_BL > SwingPhaseHeightThreshold) ? 0.0f : 1.0f;
-	float TargetAlpha_BR = (HeightAboveGround_BR > SwingPhaseHeightThreshold) ? 0.0f : 1.0f;
-
-	// Interpolate foot offsets for smooth IK
-	FootOffset_FL = FMath::FInterpTo(FootOffset_FL, RawFootOffset_FL, DeltaSeconds, IKInterpSpeed);
-	FootOffset_FR = FMath::FInterpTo(FootOffset_FR, RawFootOffset_FR, DeltaSeconds, IKInterpSpeed);
-	FootOffset_BL = FMath::FInterpTo(FootOffset_BL, RawFootOffset_BL, DeltaSeconds, IKInterpSpeed);
-	FootOffset_BR = FMath::FInterpTo(FootOffset_BR, RawFootOffset_BR, DeltaSeconds, IKInterpSpeed);
-
-	// Set per-foot IK alphas
-	// Instant off during swing (alpha = 0) so animation foot lift shows
-	// Smooth blend on during stance to avoid popping
-	if (TargetAlpha_FL < 0.5f)
-		IKAlpha_FrontLeft = 0.0f;
-	else
-		IKAlpha_FrontLeft = FMath::FInterpTo(IKAlpha_FrontLeft, TargetAlpha_FL, DeltaSeconds, FootIKBlendSpeed);
-
-	if (TargetAlpha_FR < 0.5f)
-		IKAlpha_FrontRight = 0.0f;
-	else
-		IKAlpha_FrontRight = FMath::FInterpTo(IKAlpha_FrontRight, TargetAlpha_FR, DeltaSeconds, FootIKBlendSpeed);
-
-	if (TargetAlpha_BL < 0.5f)
-		IKAlpha_BackLeft = 0.0f;
-	else
-		IKAlpha_BackLeft = FMath::FInterpTo(IKAlpha_BackLeft, TargetAlpha_BL, DeltaSeconds, FootIKBlendSpeed);
-
-	if (TargetAlpha_BR < 0.5f)
-		IKAlpha_BackRight = 0.0f;
-	else
-		IKAlpha_BackRight = FMath::FInterpTo(IKAlpha_BackRight, TargetAlpha_BR, DeltaSeconds, FootIKBlendSpeed);
 
 	// Calculate foot rotations from ground normals
-	FootRotation_FL = CalculateFootRotationFromNormal(GroundNormal_FL);
-	FootRotation_FR = CalculateFootRotationFromNormal(GroundNormal_FR);
-	FootRotation_BL = CalculateFootRotationFromNormal(GroundNormal_BL);
-	FootRotation_BR = CalculateFootRotationFromNormal(GroundNormal_BR);
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+	{
+		LegIK.FootRotation[Leg] = CalculateFootRotationFromNormal(LegIK.GroundNormal[Leg]);
+	}
 
 	// Calculate pelvis adjustment
 	CalculatePelvisRotation();
@@ -475,92 +786,135 @@ void USmartCatAnimInstance::UpdateTerrainAdaptationIK(float DeltaSeconds)
 
 	// Populate world-space IK targets for ABP consumption
 	// Target = ground position (where foot should plant when in stance)
-	IKFootTarget_FrontLeft = BoneFL + FVector(0, 0, FootOffset_FL);
-	IKFootTarget_FrontRight = BoneFR + FVector(0, 0, FootOffset_FR);
-	IKFootTarget_BackLeft = BoneBL + FVector(0, 0, FootOffset_BL);
-	IKFootTarget_BackRight = BoneBR + FVector(0, 0, FootOffset_BR);
-
-	// Build transforms with rotation
-	IKFootTransform_FrontLeft = FTransform(FootRotation_FL.Quaternion(), IKFootTarget_FrontLeft);
-	IKFootTransform_FrontRight = FTransform(FootRotation_FR.Quaternion(), IKFootTarget_FrontRight);
-	IKFootTransform_BackLeft = FTransform(FootRotation_BL.Quaternion(), IKFootTarget_BackLeft);
-	IKFootTransform_BackRight = FTransform(FootRotation_BR.Quaternion(), IKFootTarget_BackRight);
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+	{
+		LegIK.IKFootTarget[Leg] = Paws[Leg].GetLocation() + FVector(0, 0, LegIK.FootOffset[Leg]);
+		LegIK.IKFootTransform[Leg] = FTransform(LegIK.FootRotation[Leg].Quaternion(), LegIK.IKFootTarget[Leg]);
+	}
 }
 
 void USmartCatAnimInstance::UpdateProceduralIK(float DeltaSeconds)
 {
+	SMARTCATAI_SCOPE_CYCLE_COUNTER(STAT_SmartCatAI_IKProcedural);
+
 	// Full Procedural Mode:
 	// - Uses gait calculator for procedural foot movement
 	// - Combines with terrain traces
 	// - Original behavior preserved for testing/special cases
 
 	// Calculate gait outputs for each leg
-	FQuadrupedLegGaitOutput GaitFL = UQuadrupedGaitCalculator::CalculateFrontLeftLeg(GaitState, GaitConfig, MoveDirection);
-	FQuadrupedLegGaitOutput GaitFR = UQuadrupedGaitCalculator::CalculateFrontRightLeg(GaitState, GaitConfig, MoveDirection);
-	FQuadrupedLegGaitOutput GaitBL = UQuadrupedGaitCalculator::CalculateBackLeftLeg(GaitState, GaitConfig, MoveDirection);
-	FQuadrupedLegGaitOutput GaitBR = UQuadrupedGaitCalculator::CalculateBackRightLeg(GaitState, GaitConfig, MoveDirection);
-
-	// Perform traces for each foot
-	FVector HitLocation, HitNormal;
-
-	// Front Left
-	if (TraceFootToGround(BoneName_FrontLeft, HitLocation, HitNormal))
+	FQuadrupedLegGaitOutput Gait[EQuadrupedLeg::Num];
+	if (GameThreadData.bBatchedGait)
 	{
-		RawFootLocation_FrontLeft = HitLocation + FVector(0, 0, FootHeight);
-		FVector BoneLocation = CachedMesh->GetSocketLocation(BoneName_FrontLeft);
-		FootOffset_FrontLeft = CalculateFootOffset(RawFootLocation_FrontLeft, BoneLocation);
+		for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+		{
+			Gait[Leg] = GameThreadData.BatchedGaitLegs[Leg];
+		}
 	}
-
-	// Front Right
-	if (TraceFootToGround(BoneName_FrontRight, HitLocation, HitNormal))
+	else
 	{
-		RawFootLocation_FrontRight = HitLocation + FVector(0, 0, FootHeight);
-		FVector BoneLocation = CachedMesh->GetSocketLocation(BoneName_FrontRight);
-		FootOffset_FrontRight = CalculateFootOffset(RawFootLocation_FrontRight, BoneLocation);
+		UQuadrupedGaitCalculator::CalculateAllLegs(GaitState, GaitConfig, MoveDirection, Gait);
 	}
 
-	// Back Left
-	if (TraceFootToGround(BoneName_BackLeft, HitLocation, HitNormal))
-	{
-		RawFootLocation_BackLeft = HitLocation + FVector(0, 0, FootHeight);
-		FVector BoneLocation = CachedMesh->GetSocketLocation(BoneName_BackLeft);
-		FootOffset_BackLeft = CalculateFootOffset(RawFootLocation_BackLeft, BoneLocation);
-	}
+	// Use the traces gathered for each foot
+	const FCatFootTraceResult* Traces = GameThreadData.FootTraces;
+	const FTransform* Paws = GameThreadData.Bones.Paws;
 
-	// Back Right
-	if (TraceFootToGround(BoneName_BackRight, HitLocation, HitNormal))
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
 	{
-		RawFootLocation_BackRight = HitLocation + FVector(0, 0, FootHeight);
-		FVector BoneLocation = CachedMesh->GetSocketLocation(BoneName_BackRight);
-		FootOffset_BackRight = CalculateFootOffset(RawFootLocation_BackRight, BoneLocation);
-	}
+		if (Traces[Leg].bHit)
+		{
+			LegIK.RawFootLocation[Leg] = Traces[Leg].HitLocation + FVector(0, 0, FootHeight);
+			LegIK.ProceduralFootOffset[Leg] = CalculateFootOffset(LegIK.RawFootLocation[Leg], Paws[Leg].GetLocation());
+		}
 
-	// Apply gait offsets to foot targets
-	IKFootTarget_FrontLeft = RawFootLocation_FrontLeft + GaitFL.PositionOffset;
-	IKFootTarget_FrontRight = RawFootLocation_FrontRight + GaitFR.PositionOffset;
-	IKFootTarget_BackLeft = RawFootLocation_BackLeft + GaitBL.PositionOffset;
-	IKFootTarget_BackRight = RawFootLocation_BackRight + GaitBR.PositionOffset;
+		// Apply gait offsets to foot targets
+		LegIK.IKFootTarget[Leg] = LegIK.RawFootLocation[Leg] + Gait[Leg].PositionOffset;
 
-	// Build full effector transforms (location + rotation) for FABRIK
-	IKFootTransform_FrontLeft = FTransform(GaitFL.EffectorRotation.Quaternion(), IKFootTarget_FrontLeft);
-	IKFootTransform_FrontRight = FTransform(GaitFR.EffectorRotation.Quaternion(), IKFootTarget_FrontRight);
-	IKFootTransform_BackLeft = FTransform(GaitBL.EffectorRotation.Quaternion(), IKFootTarget_BackLeft);
-	IKFootTransform_BackRight = FTransform(GaitBR.EffectorRotation.Quaternion(), IKFootTarget_BackRight);
+		// Build full effector transforms (location + rotation) for FABRIK
+		LegIK.IKFootTransform[Leg] = FTransform(Gait[Leg].EffectorRotation.Quaternion(), LegIK.IKFootTarget[Leg]);
+	}
 
 	// Set pelvis offset directly
 	PelvisOffset = CalculatePelvisOffset();
 	PelvisOffsetZ = PelvisOffset.Z;
 }
 
-bool USmartCatAnimInstance::TraceFootToGround(const FName& BoneName, FVector& OutHitLocation, FVector& OutHitNormal)
+void USmartCatAnimInstance::PublishLegMirrors()
+{
+	// Blueprint-visible copies of the per-leg arrays for the AnimBP
+	FootOffset_FL = LegIK.FootOffset[EQuadrupedLeg::FrontLeft];
+	FootOffset_FR = LegIK.FootOffset[EQuadrupedLeg::FrontRight];
+	FootOffset_BL = LegIK.FootOffset[EQuadrupedLeg::BackLeft];
+	FootOffset_BR = LegIK.FootOffset[EQuadrupedLeg::BackRight];
+
+	GroundNormal_FL = LegIK.GroundNormal[EQuadrupedLeg::FrontLeft];
+	GroundNormal_FR = LegIK.GroundNormal[EQuadrupedLeg::FrontRight];
+	GroundNormal_BL = LegIK.GroundNormal[EQuadrupedLeg::BackLeft];
+	GroundNormal_BR = LegIK.GroundNormal[EQuadrupedLeg::BackRight];
+
+	FootRotation_FL = LegIK.FootRotation[EQuadrupedLeg::FrontLeft];
+	FootRotation_FR = LegIK.FootRotation[EQuadrupedLeg::FrontRight];
+	FootRotation_BL = LegIK.FootRotation[EQuadrupedLeg::BackLeft];
+	FootRotation_BR = LegIK.FootRotation[EQuadrupedLeg::BackRight];
+
+	GroundZ_FL = LegIK.GroundZ[EQuadrupedLeg::FrontLeft];
+	GroundZ_FR = LegIK.GroundZ[EQuadrupedLeg::FrontRight];
+	GroundZ_BL = LegIK.GroundZ[EQuadrupedLeg::BackLeft];
+	GroundZ_BR = LegIK.GroundZ[EQuadrupedLeg::BackRight];
+
+	ResidualOffset_FL = LegIK.ResidualOffset[EQuadrupedLeg::FrontLeft];
+	ResidualOffset_FR = LegIK.ResidualOffset[EQuadrupedLeg::FrontRight];
+	ResidualOffset_BL = LegIK.ResidualOffset[EQuadrupedLeg::BackLeft];
+	ResidualOffset_BR = LegIK.ResidualOffset[EQuadrupedLeg::BackRight];
+
+	IKFootTarget_FrontLeft = LegIK.IKFootTarget[EQuadrupedLeg::FrontLeft];
+	IKFootTarget_FrontRight = LegIK.IKFootTarget[EQuadrupedLeg::FrontRight];
+	IKFootTarget_BackLeft = LegIK.IKFootTarget[EQuadrupedLeg::BackLeft];
+	IKFootTarget_BackRight = LegIK.IKFootTarget[EQuadrupedLeg::BackRight];
+
+	IKFootTransform_FrontLeft = LegIK.IKFootTransform[EQuadrupedLeg::FrontLeft];
+	IKFootTransform_FrontRight = LegIK.IKFootTransform[EQuadrupedLeg::FrontRight];
+	IKFootTransform_BackLeft = LegIK.IKFootTransform[EQuadrupedLeg::BackLeft];
+	IKFootTransform_BackRight = LegIK.IKFootTransform[EQuadrupedLeg::BackRight];
+
+	IKAlpha_FrontLeft = LegIK.IKAlpha[EQuadrupedLeg::FrontLeft];
+	IKAlpha_FrontRight = LegIK.IKAlpha[EQuadrupedLeg::FrontRight];
+	IKAlpha_BackLeft = LegIK.IKAlpha[EQuadrupedLeg::BackLeft];
+	IKAlpha_BackRight = LegIK.IKAlpha[EQuadrupedLeg::BackRight];
+}
+
+void USmartCatAnimInstance::SeedLegAlphas()
+{
+	LegIK.IKAlpha[EQuadrupedLeg::FrontLeft] = IKAlpha_FrontLeft;
+	LegIK.IKAlpha[EQuadrupedLeg::FrontRight] = IKAlpha_FrontRight;
+	LegIK.IKAlpha[EQuadrupedLeg::BackLeft] = IKAlpha_BackLeft;
+	LegIK.IKAlpha[EQuadrupedLeg::BackRight] = IKAlpha_BackRight;
+}
+
+bool USmartCatAnimInstance::TraceFootToGround(int32 Leg, const FVector& PawLocation, FVector& OutHitLocation, FVector& OutHitNormal)
 {
-	if (!CachedMesh || !CatCharacter)
+	// Async mode: use the batch result collected this frame (traced from last frame's pose)
+	if (bUseAsyncFootTraces && AsyncFootTraceResults[Leg].bValid)
 	{
-		return false;
+		const FCatFootTraceResult& Result = AsyncFootTraceResults[Leg];
+		OutHitLocation = Result.HitLocation;
+		OutHitNormal = Result.HitNormal;
+		return Result.bHit;
 	}
 
-	// Get bone location in world space
-	FVector BoneLocation = CachedMesh->GetSocketLocation(BoneName);
+	// Fallback - blocking trace
+	return TraceFootToGroundSync(PawLocation, OutHitLocation, OutHitNormal);
+}
+
+bool USmartCatAnimInstance::TraceFootToGroundSync(const FVector& BoneLocation, FVector& OutHitLocation, FVector& OutHitNormal)
+{
+	SMARTCATAI_SCOPE_CYCLE_COUNTER(STAT_SmartCatAI_Traces);
+
+	if (!CatCharacter)
+	{
+		return false;
+	}
 
 	// Calculate trace start and end
 	FVector TraceStart = BoneLocation + FVector(0, 0, TraceStartOffset);
@@ -572,6 +926,7 @@ bool USmartCatAnimInstance::TraceFootToGround(const FName& BoneName, FVector& Ou
 	QueryParams.bTraceComplex = false;
 	QueryParams.bReturnPhysicalMaterial = false;
 
+	SMARTCATAI_COUNT_TRACE();
 	FHitResult HitResult;
 	bool bHit = CatCharacter->GetWorld()->LineTraceSingleByChannel(
 		HitResult,
@@ -623,6 +978,199 @@ bool USmartCatAnimInstance::TraceFootToGround(const FName& BoneName, FVector& Ou
 	return false;
 }
 
+void USmartCatAnimInstance::SubmitAsyncFootTraces()
+{
+	SMARTCATAI_SCOPE_CYCLE_COUNTER(STAT_SmartCatAI_Traces);
+
+	if (!CatCharacter || !GameThreadData.Bones.bValid)
+	{
+		return;
+	}
+
+	UWorld* World = CatCharacter->GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	// Same parameters as the blocking trace, shared by the whole batch
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CatFootTrace), false, CatCharacter);
+	QueryParams.bReturnPhysicalMaterial = false;
+
+	// The results are read next frame, so a cached sample must still be young enough then
+	const double NextFrameTime = World->GetTimeSeconds() + World->GetDeltaSeconds();
+
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+	{
+		const FVector BoneLocation = GameThreadData.Bones.Paws[Leg].GetLocation();
+
+		// Cached sample will very likely still cover this paw next frame. Half the threshold
+		// leaves room for a slow paw, which then gets a trace queued before it leaves the cache;
+		// a sample about to expire gets one too, or an idle paw would fall back to a blocking trace.
+		FCatFootTraceResult Unused;
+		if (bUseGroundSampleCache
+			&& NextFrameTime - GroundSamples[Leg].Time <= GroundCacheMaxAge
+			&& LookupGroundSample(Leg, BoneLocation, GroundCacheMoveThreshold * 0.5f, Unused))
+		{
+			AsyncFootTraceHandles[Leg].Invalidate();
+			continue;
+		}
+
+		AsyncFootTraceOrigins[Leg] = BoneLocation;
+
+		SMARTCATAI_COUNT_TRACE();
+
+		// UserData carries the leg index so results can be matched back up
+		AsyncFootTraceHandles[Leg] = World->AsyncLineTraceByChannel(
+			EAsyncTraceType::Single,
+			BoneLocation + FVector(0, 0, TraceStartOffset),
+			BoneLocation - FVector(0, 0, TraceEndOffset),
+			TraceChannel,
+			QueryParams,
+			FCollisionResponseParams::DefaultResponseParam,
+			nullptr,
+			static_cast<uint32>(Leg)
+		);
+	}
+}
+
+void USmartCatAnimInstance::CollectAsyncFootTraces()
+{
+	SMARTCATAI_SCOPE_CYCLE_COUNTER(STAT_SmartCatAI_Traces);
+
+	UWorld* World = CatCharacter ? CatCharacter->GetWorld() : nullptr;
+
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+	{
+		FCatFootTraceResult& Result = AsyncFootTraceResults[Leg];
+		Result.bValid = false;
+
+		FTraceDatum Datum;
+		if (!World || !AsyncFootTraceHandles[Leg].IsValid() || !World->QueryTraceData(AsyncFootTraceHandles[Leg], Datum))
+		{
+			// Not ready (or never submitted) - TraceFootToGround falls back to a blocking trace
+			continue;
+		}
+		AsyncFootTraceHandles[Leg].Invalidate();
+
+		const FHitResult* Hit = Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit ? &Datum.OutHits[0] : nullptr;
+
+#if ENABLE_DRAW_DEBUG
+		if (bDrawDebugTraces)
+		{
+			DrawDebugLine(World, Datum.Start, Datum.End, Hit ? FColor::Green : FColor::Red, false, -1.0f, 0, 1.0f);
+			if (Hit)
+			{
+				DrawDebugSphere(World, Hit->ImpactPoint, 3.0f, 8, FColor::Yellow, false, -1.0f);
+			}
+		}
+#endif
+
+		Result.bValid = true;
+		Result.bHit = (Hit != nullptr);
+		Result.HitLocation = Hit ? FVector(Hit->ImpactPoint) : AsyncFootTraceOrigins[Leg];
+		Result.HitNormal = Hit ? FVector(Hit->ImpactNormal) : FVector::UpVector;
+	}
+}
+
+void USmartCatAnimInstance::ResetAsyncFootTraces()
+{
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+	{
+		AsyncFootTraceHandles[Leg].Invalidate();
+		AsyncFootTraceResults[Leg].bValid = false;
+	}
+}
+
+bool USmartCatAnimInstance::LookupGroundSample(int32 Leg, const FVector& PawLocation, float MaxDistance, FCatFootTraceResult& OutResult) const
+{
+	const FCatGroundSample& Sample = GroundSamples[Leg];
+	if (!Sample.Result.bValid
+		|| GroundSampleNow - Sample.Time > GroundCacheMaxAge
+		|| FVector::DistSquared(Sample.PawLocation, PawLocation) > FMath::Square(MaxDistance))
+	{
+		return false;
+	}
+
+	OutResult = Sample.Result;
+
+	// A miss reports the paw itself as the hit location, so follow the paw
+	if (!OutResult.bHit)
+	{
+		OutResult.HitLocation = PawLocation;
+	}
+	return true;
+}
+
+void USmartCatAnimInstance::StoreGroundSample(int32 Leg, const FVector& PawLocation, const FCatFootTraceResult& Result)
+{
+	FCatGroundSample& Sample = GroundSamples[Leg];
+	Sample.PawLocation = PawLocation;
+	Sample.Result = Result;
+	Sample.Time = GroundSampleNow;
+}
+
+void USmartCatAnimInstance::InvalidateGroundSamples()
+{
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+	{
+		GroundSamples[Leg].Result.bValid = false;
+	}
+}
+
+const FName& USmartCatAnimInstance::GetLegBoneName(int32 Leg) const
+{
+	switch (Leg)
+	{
+	case EQuadrupedLeg::FrontLeft: return BoneName_FrontLeft;
+	case EQuadrupedLeg::FrontRight: return BoneName_FrontRight;
+	case EQuadrupedLeg::BackLeft: return BoneName_BackLeft;
+	default: return BoneName_BackRight;
+	}
+}
+
+void USmartCatAnimInstance::ResolveBoneIndices()
+{
+	BoneIndices.ResolvedMesh = CachedMesh->GetSkeletalMeshAsset();
+
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+	{
+		BoneIndices.Paws[Leg] = CachedMesh->GetBoneIndex(GetLegBoneName(Leg));
+	}
+	BoneIndices.Pelvis = CachedMesh->GetBoneIndex(BoneName_Pelvis);
+	BoneIndices.Bell = CachedMesh->GetBoneIndex(BoneName_Bell);
+	BoneIndices.Jaw = CachedMesh->GetBoneIndex(BoneName_Jaw);
+}
+
+void USmartCatAnimInstance::CaptureBoneSnapshot(FCatBoneSnapshot& OutSnapshot)
+{
+	// Mesh asset swapped since the indices were resolved
+	if (BoneIndices.ResolvedMesh.Get() != CachedMesh->GetSkeletalMeshAsset())
+	{
+		ResolveBoneIndices();
+	}
+
+	// One component transform for all bones instead of one lookup per GetSocketLocation call
+	const FTransform& ComponentToWorld = CachedMesh->GetComponentTransform();
+
+	// Names that aren't bones (e.g. sockets) still go through the name lookup
+	auto FetchTransform = [this, &ComponentToWorld](int32 BoneIndex, const FName& Name) -> FTransform
+	{
+		return BoneIndex != INDEX_NONE
+			? CachedMesh->GetBoneTransform(BoneIndex, ComponentToWorld)
+			: CachedMesh->GetSocketTransform(Name);
+	};
+
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+	{
+		OutSnapshot.Paws[Leg] = FetchTransform(BoneIndices.Paws[Leg], GetLegBoneName(Leg));
+	}
+	OutSnapshot.Pelvis = FetchTransform(BoneIndices.Pelvis, BoneName_Pelvis);
+	OutSnapshot.Bell = FetchTransform(BoneIndices.Bell, BoneName_Bell);
+	OutSnapshot.Jaw = FetchTransform(BoneIndices.Jaw, BoneName_Jaw);
+	OutSnapshot.bValid = true;
+}
+
 float USmartCatAnimInstance::CalculateFootOffset(const FVector& TraceHitLocation, const FVector& BoneWorldLocation)
 {
 	// Calculate the Z difference between where the foot should be and where it is
@@ -636,9 +1184,10 @@ FVector USmartCatAnimInstance::CalculatePelvisOffset()
 {
 	// Find the minimum (most negative) foot offset
 	// The pelvis needs to lower to accommodate the foot that needs to reach lowest
+	const float* Offsets = LegIK.ProceduralFootOffset;
 	float MinOffset = FMath::Min(
-		FMath::Min(FootOffset_FrontLeft, FootOffset_FrontRight),
-		FMath::Min(FootOffset_BackLeft, FootOffset_BackRight)
+		FMath::Min(Offsets[EQuadrupedLeg::FrontLeft], Offsets[EQuadrupedLeg::FrontRight]),
+		FMath::Min(Offsets[EQuadrupedLeg::BackLeft], Offsets[EQuadrupedLeg::BackRight])
 	);
 
 	// Only apply pelvis adjustment for negative offsets (lowering the body)
@@ -714,9 +1263,10 @@ ECatIKMode USmartCatAnimInstance::GetEffectiveIKMode() const
 void USmartCatAnimInstance::CalculatePelvisRotation()
 {
 	// Calculate pelvis Z offset (lowest foot determines body height)
+	const float* Offsets = LegIK.FootOffset;
 	float MinOffset = FMath::Min(
-		FMath::Min(FootOffset_FL, FootOffset_FR),
-		FMath::Min(FootOffset_BL, FootOffset_BR)
+		FMath::Min(Offsets[EQuadrupedLeg::FrontLeft], Offsets[EQuadrupedLeg::FrontRight]),
+		FMath::Min(Offsets[EQuadrupedLeg::BackLeft], Offsets[EQuadrupedLeg::BackRight])
 	);
 
 	// Only lower the pelvis, never raise it above animation
@@ -724,42 +1274,37 @@ void USmartCatAnimInstance::CalculatePelvisRotation()
 
 	// Calculate pitch from front/back height difference
 	// Positive pitch = nose up (when front feet are higher than back)
-	float FrontAvgZ = (FootOffset_FL + FootOffset_FR) * 0.5f;
-	float BackAvgZ = (FootOffset_BL + FootOffset_BR) * 0.5f;
+	float FrontAvgZ = (Offsets[EQuadrupedLeg::FrontLeft] + Offsets[EQuadrupedLeg::FrontRight]) * 0.5f;
+	float BackAvgZ = (Offsets[EQuadrupedLeg::BackLeft] + Offsets[EQuadrupedLeg::BackRight]) * 0.5f;
 
 	// Get approximate body length for angle calculation
-	// Use bone positions to estimate
-	if (CachedMesh)
-	{
-		FVector FrontMid = (CachedMesh->GetSocketLocation(BoneName_FrontLeft) + CachedMesh->GetSocketLocation(BoneName_FrontRight)) * 0.5f;
-		FVector BackMid = (CachedMesh->GetSocketLocation(BoneName_BackLeft) + CachedMesh->GetSocketLocation(BoneName_BackRight)) * 0.5f;
-		float ComputedBodyLength = FVector::Dist2D(FrontMid, BackMid);
+	// Use bone positions gathered on the game thread to estimate
+	const FTransform* Paws = GameThreadData.Bones.Paws;
+	FVector FrontMid = (Paws[EQuadrupedLeg::FrontLeft].GetLocation() + Paws[EQuadrupedLeg::FrontRight].GetLocation()) * 0.5f;
+	FVector BackMid = (Paws[EQuadrupedLeg::BackLeft].GetLocation() + Paws[EQuadrupedLeg::BackRight].GetLocation()) * 0.5f;
+	float ComputedBodyLength = FVector::Dist2D(FrontMid, BackMid);
 
-		if (ComputedBodyLength > 1.0f)
-		{
-			float HeightDiff = FrontAvgZ - BackAvgZ;
-			PelvisPitch = FMath::RadiansToDegrees(FMath::Atan2(HeightDiff, ComputedBodyLength));
-			PelvisPitch = FMath::Clamp(PelvisPitch, -15.0f, 15.0f); // Limit rotation
-		}
+	if (ComputedBodyLength > 1.0f)
+	{
+		float HeightDiff = FrontAvgZ - BackAvgZ;
+		PelvisPitch = FMath::RadiansToDegrees(FMath::Atan2(HeightDiff, ComputedBodyLength));
+		PelvisPitch = FMath::Clamp(PelvisPitch, -15.0f, 15.0f); // Limit rotation
 	}
 
 	// Calculate roll from left/right height difference
 	// Positive roll = right side up (when left feet are higher than right)
-	float LeftAvgZ = (FootOffset_FL + FootOffset_BL) * 0.5f;
-	float RightAvgZ = (FootOffset_FR + FootOffset_BR) * 0.5f;
+	float LeftAvgZ = (Offsets[EQuadrupedLeg::FrontLeft] + Offsets[EQuadrupedLeg::BackLeft]) * 0.5f;
+	float RightAvgZ = (Offsets[EQuadrupedLeg::FrontRight] + Offsets[EQuadrupedLeg::BackRight]) * 0.5f;
 
-	if (CachedMesh)
-	{
-		FVector LeftMid = (CachedMesh->GetSocketLocation(BoneName_FrontLeft) + CachedMesh->GetSocketLocation(BoneName_BackLeft)) * 0.5f;
-		FVector RightMid = (CachedMesh->GetSocketLocation(BoneName_FrontRight) + CachedMesh->GetSocketLocation(BoneName_BackRight)) * 0.5f;
-		float ComputedBodyWidth = FVector::Dist2D(LeftMid, RightMid);
+	FVector LeftMid = (Paws[EQuadrupedLeg::FrontLeft].GetLocation() + Paws[EQuadrupedLeg::BackLeft].GetLocation()) * 0.5f;
+	FVector RightMid = (Paws[EQuadrupedLeg::FrontRight].GetLocation() + Paws[EQuadrupedLeg::BackRight].GetLocation()) * 0.5f;
+	float ComputedBodyWidth = FVector::Dist2D(LeftMid, RightMid);
 
-		if (ComputedBodyWidth > 1.0f)
-		{
-			float HeightDiff = LeftAvgZ - RightAvgZ;
-			PelvisRoll = FMath::RadiansToDegrees(FMath::Atan2(HeightDiff, ComputedBodyWidth));
-			PelvisRoll = FMath::Clamp(PelvisRoll, -10.0f, 10.0f); // Limit rotation
-		}
+	if (ComputedBodyWidth > 1.0f)
+	{
+		float HeightDiff = LeftAvgZ - RightAvgZ;
+		PelvisRoll = FMath::RadiansToDegrees(FMath::Atan2(HeightDiff, ComputedBodyWidth));
+		PelvisRoll = FMath::Clamp(PelvisRoll, -10.0f, 10.0f); // Limit rotation
 	}
 
 	// Combine into pelvis rotation
@@ -787,31 +1332,54 @@ void USmartCatAnimInstance::TriggerAction(ECatAnimationAction Action)
 
 void USmartCatAnimInstance::ClearAction()
 {
+	const ECatAnimationAction FinishedAction = CurrentAction;
+	const bool bWasPlayingAction = bIsPlayingAction;
+
 	CurrentAction = ECatAnimationAction::None;
 	bIsPlayingAction = false;
+
+	if (bWasPlayingAction)
+	{
+		OnActionFinished.Broadcast(FinishedAction);
+	}
+}
+
+void USmartCatAnimInstance::SetIKLODEnabled(bool bEnabled)
+{
+	bEnableIKLOD = bEnabled;
+	if (!bEnableIKLOD)
+	{
+		CurrentIKLOD = ECatIKLOD::Full;
+	}
 }
 
 void USmartCatAnimInstance::StartRuntimeDebugRecording()
 {
-	bIsRecordingDebug = true;
-
-	// Write header immediately to file
-	FString FilePath = FPaths::ProjectSavedDir() / TEXT("RuntimeIKDebug.csv");
-	FString Header = TEXT("Time,Speed,");
-	Header += TEXT("FL_Z,FL_GroundZ,FL_Diff,");
-	Header += TEXT("FR_Z,FR_GroundZ,FR_Diff,");
-	Header += TEXT("BL_Z,BL_GroundZ,BL_Diff,");
-	Header += TEXT("BR_Z,BR_GroundZ,BR_Diff,");
-	Header += TEXT("Bell_Z,Bell_GroundZ,Bell_Diff,");
-	Header += TEXT("Jaw_Z,Jaw_GroundZ,Jaw_Diff\n");
-
-	FFileHelper::SaveStringToFile(Header, *FilePath);
-	UE_LOG(LogTemp, Warning, TEXT("SmartCatAI: Started runtime debug recording to %s"), *FilePath);
+	if (!DebugRecorder)
+	{
+		DebugRecorder = MakeUnique<FSmartCatIKRecorder>();
+	}
+
+	// Rows go to a columnar trace file on the recorder thread; the CSV is produced on stop
+	const FString BinaryPath = FPaths::ProjectSavedDir() / TEXT("RuntimeIKDebug.sctrace");
+	const FString CsvPath = FPaths::ProjectSavedDir() / TEXT("RuntimeIKDebug.csv");
+
+	bIsRecordingDebug = DebugRecorder->StartRecording(BinaryPath, CsvPath);
+	DebugRecordingTime = 0.0f;
+
+	if (bIsRecordingDebug)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SmartCatAI: Started runtime debug recording to %s"), *BinaryPath);
+	}
 }
 
 void USmartCatAnimInstance::StopRuntimeDebugRecording()
 {
 	bIsRecordingDebug = false;
+	if (DebugRecorder)
+	{
+		DebugRecorder->StopRecording();
+	}
 	UE_LOG(LogTemp, Warning, TEXT("SmartCatAI: Stopped runtime debug recording"));
 }
 
@@ -826,26 +1394,33 @@ void USmartCatAnimInstance::PrintDebugState()
 		}
 	}
 
+	// Reuse this frame's bone snapshot if the update already took one
+	FCatBoneSnapshot Bones = GameThreadData.Bones;
+	if (!Bones.bValid)
+	{
+		CaptureBoneSnapshot(Bones);
+	}
+
 	// Get bone world positions
-	FVector BoneFL = CachedMesh->GetSocketLocation(BoneName_FrontLeft);
-	FVector BoneFR = CachedMesh->GetSocketLocation(BoneName_FrontRight);
-	FVector BoneBL = CachedMesh->GetSocketLocation(BoneName_BackLeft);
-	FVector BoneBR = CachedMesh->GetSocketLocation(BoneName_BackRight);
-	FVector BoneBell = CachedMesh->GetSocketLocation(BoneName_Bell);
-	FVector BoneJaw = CachedMesh->GetSocketLocation(BoneName_Jaw);
+	FVector BoneFL = Bones.Paws[EQuadrupedLeg::FrontLeft].GetLocation();
+	FVector BoneFR = Bones.Paws[EQuadrupedLeg::FrontRight].GetLocation();
+	FVector BoneBL = Bones.Paws[EQuadrupedLeg::BackLeft].GetLocation();
+	FVector BoneBR = Bones.Paws[EQuadrupedLeg::BackRight].GetLocation();
+	FVector BoneBell = Bones.Bell.GetLocation();
+	FVector BoneJaw = Bones.Jaw.GetLocation();
 
 	// Trace to find ground at each location
 	FVector HitLocation, HitNormal;
 	float LocalGroundZ_FL = 0.0f, LocalGroundZ_FR = 0.0f, LocalGroundZ_BL = 0.0f, LocalGroundZ_BR = 0.0f;
 	float LocalGroundZ_Bell = 0.0f, LocalGroundZ_Jaw = 0.0f;
 
-	if (TraceFootToGround(BoneName_FrontLeft, HitLocation, HitNormal))
+	if (TraceFootToGround(EQuadrupedLeg::FrontLeft, BoneFL, HitLocation, HitNormal))
 		LocalGroundZ_FL = HitLocation.Z;
-	if (TraceFootToGround(BoneName_FrontRight, HitLocation, HitNormal))
+	if (TraceFootToGround(EQuadrupedLeg::FrontRight, BoneFR, HitLocation, HitNormal))
 		LocalGroundZ_FR = HitLocation.Z;
-	if (TraceFootToGround(BoneName_BackLeft, HitLocation, HitNormal))
+	if (TraceFootToGround(EQuadrupedLeg::BackLeft, BoneBL, HitLocation, HitNormal))
 		LocalGroundZ_BL = HitLocation.Z;
-	if (TraceFootToGround(BoneName_BackRight, HitLocation, HitNormal))
+	if (TraceFootToGround(EQuadrupedLeg::BackRight, BoneBR, HitLocation, HitNormal))
 		LocalGroundZ_BR = HitLocation.Z;
 
 	// Trace for Bell and Jaw (use same trace method but from those bone positions)
@@ -945,107 +1520,278 @@ void USmartCatAnimInstance::PrintDebugState()
 		}
 	}
 
-	// Always append to file if recording
-	if (bIsRecordingDebug)
+	// Queue a row for the recorder thread if recording
+	if (bIsRecordingDebug && DebugRecorder)
+	{
+		DebugRecordingTime += GetWorld() ? GetWorld()->GetDeltaSeconds() : 0.016f;
+
+		FSmartCatIKDebugRow Row;
+		Row.Time = DebugRecordingTime;
+		Row.Speed = GroundSpeed;
+
+		const FVector BonePoints[FSmartCatIKDebugRow::NumPoints] = { BoneFL, BoneFR, BoneBL, BoneBR, BoneBell, BoneJaw };
+		const float GroundPoints[FSmartCatIKDebugRow::NumPoints] =
+		{
+			LocalGroundZ_FL, LocalGroundZ_FR, LocalGroundZ_BL, LocalGroundZ_BR, LocalGroundZ_Bell, LocalGroundZ_Jaw
+		};
+		for (int32 Point = 0; Point < FSmartCatIKDebugRow::NumPoints; ++Point)
+		{
+			Row.BoneZ[Point] = BonePoints[Point].Z;
+			Row.GroundZ[Point] = GroundPoints[Point];
+		}
+
+		DebugRecorder->AppendRow(Row);
+	}
+}
+
+void USmartCatAnimInstance::RecordIKFlightFrame(float DeltaSeconds)
+{
+	if (!bEnableIKFlightRecorder || !IKFlightRecorder.IsInitialized())
+	{
+		return;
+	}
+
+	FlightRecorderTime += DeltaSeconds;
+
+	FSmartCatIKFlightFrame Frame;
+	Frame.Time = FlightRecorderTime;
+	Frame.GroundSpeed = GroundSpeed;
+	Frame.GaitPhase = GaitState.GaitCyclePhase;
+	Frame.SlopePitch = SlopePitch;
+	Frame.SlopeRoll = SlopeRoll;
+	Frame.PelvisOffsetZ = PelvisOffsetZ;
+	Frame.IKMode = static_cast<uint8>(GameThreadData.EffectiveIKMode);
+	Frame.IKLOD = static_cast<uint8>(CurrentIKLOD);
+	Frame.Gait = static_cast<uint8>(GaitState.DetectedGait);
+
+	uint8 Anomalies = FSmartCatIKFlightFrame::None;
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+	{
+		Frame.PawZ[Leg] = GameThreadData.Bones.Paws[Leg].GetLocation().Z;
+		Frame.GroundZ[Leg] = GameThreadData.FootTraces[Leg].HitLocation.Z;
+		Frame.FootOffset[Leg] = LegIK.FootOffset[Leg];
+		Frame.ResidualOffset[Leg] = LegIK.ResidualOffset[Leg];
+		Frame.IKAlpha[Leg] = LegIK.IKAlpha[Leg];
+
+		if (LegIK.IKFootTarget[Leg].ContainsNaN())
+		{
+			Anomalies |= FSmartCatIKFlightFrame::NaNTarget;
+		}
+
+		// Only planted feet with IK applied can visibly glitch
+		if (bIKEnabled && LegIK.IKAlpha[Leg] > 0.5f)
+		{
+			if (FMath::Abs(LegIK.FootOffset[Leg]) >= MaxIKOffset - KINDA_SMALL_NUMBER)
+			{
+				Anomalies |= FSmartCatIKFlightFrame::PinnedOffset;
+			}
+			if (FMath::Abs(LegIK.FootOffset[Leg] - FlightRecorderPrevFootOffset[Leg]) > FlightRecorderPopThreshold)
+			{
+				Anomalies |= FSmartCatIKFlightFrame::OffsetPop;
+			}
+		}
+		FlightRecorderPrevFootOffset[Leg] = LegIK.FootOffset[Leg];
+	}
+	Frame.Anomalies = Anomalies;
+
+	IKFlightRecorder.Record(Frame);
+
+#if !UE_BUILD_SHIPPING
+	// File I/O belongs on the game thread side; just flag it here, at most once per cooldown per cat
+	if (Anomalies != FSmartCatIKFlightFrame::None && bDumpFlightRecorderOnAnomaly
+		&& FlightRecorderTime - FlightRecorderLastDumpTime >= FlightRecorderDumpCooldown)
+	{
+		FlightRecorderLastDumpTime = FlightRecorderTime;
+		PendingFlightRecorderAnomalies.fetch_or(Anomalies);
+	}
+#endif
+}
+
+FString USmartCatAnimInstance::DumpIKFlightRecorder(const FString& Reason)
+{
+	if (!IKFlightRecorder.IsInitialized())
 	{
-		static float RecordingTime = 0.0f;
-		RecordingTime += GetWorld() ? GetWorld()->GetDeltaSeconds() : 0.016f;
+		return FString();
+	}
 
-		FString Row = FString::Printf(TEXT("%.3f,%.1f,"),
-			RecordingTime, GroundSpeed);
+	// Copy out now (a few tens of KB), format and write on a pool thread
+	TArray<FSmartCatIKFlightFrame> Frames;
+	IKFlightRecorder.Snapshot(Frames);
 
-		Row += FString::Printf(TEXT("%.2f,%.2f,%.2f,"),
-			BoneFL.Z, LocalGroundZ_FL, Diff_FL);
+	const FString OwnerName = CatCharacter ? CatCharacter->GetName() : GetName();
+	const FString Path = FPaths::ProjectSavedDir() / TEXT("SmartCatIK")
+		/ FString::Printf(TEXT("FlightRecorder_%s_%s.csv"), *OwnerName, *FDateTime::Now().ToString());
 
-		Row += FString::Printf(TEXT("%.2f,%.2f,%.2f,"),
-			BoneFR.Z, LocalGroundZ_FR, Diff_FR);
+	UE_LOG(LogTemp, Warning, TEXT("SmartCatAI: Dumping IK flight recorder (%d frames, %s) to %s"), Frames.Num(), *Reason, *Path);
+
+	Async(EAsyncExecution::ThreadPool, [Path, Reason, Frames = MoveTemp(Frames)]()
+	{
+		FSmartCatIKFlightRecorder::WriteCsv(Path, Reason, Frames);
+	});
 
-		Row += FString::Printf(TEXT("%.2f,%.2f,%.2f,"),
-			BoneBL.Z, LocalGroundZ_BL, Diff_BL);
+	return Path;
+}
 
-		Row += FString::Printf(TEXT("%.2f,%.2f,%.2f,"),
-			BoneBR.Z, LocalGroundZ_BR, Diff_BR);
+void USmartCatAnimInstance::SweepGaitAtSpeed(const FQuadrupedGaitConfig& Config, float Speed, float TimeStep, float CycleDuration,
+	TFunctionRef<void(float Speed, float Time, const FQuadrupedGaitState& State, const FQuadrupedLegGaitOutput (&Legs)[EQuadrupedLeg::Num])> Visit)
+{
+	// Create a fresh gait state for this speed
+	FQuadrupedGaitState TestState;
+	FVector TestVelocity = FVector(Speed, 0, 0); // Forward velocity
+	FVector MoveDir = FVector(1, 0, 0);
 
-		Row += FString::Printf(TEXT("%.2f,%.2f,%.2f,"),
-			BoneBell.Z, LocalGroundZ_Bell, Diff_Bell);
+	// Simulate for CycleDuration seconds
+	for (float Time = 0.0f; Time < CycleDuration; Time += TimeStep)
+	{
+		// Update gait state
+		UQuadrupedGaitCalculator::UpdateGaitState(TestState, Config, TestVelocity, TimeStep);
 
-		Row += FString::Printf(TEXT("%.2f,%.2f,%.2f\n"),
-			BoneJaw.Z, LocalGroundZ_Jaw, Diff_Jaw);
+		// Calculate leg outputs
+		FQuadrupedLegGaitOutput Legs[EQuadrupedLeg::Num];
+		UQuadrupedGaitCalculator::CalculateAllLegs(TestState, Config, MoveDir, Legs);
 
-		// Append directly to file
-		FString FilePath = FPaths::ProjectSavedDir() / TEXT("RuntimeIKDebug.csv");
-		FFileHelper::SaveStringToFile(Row, *FilePath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), EFileWrite::FILEWRITE_Append);
+		Visit(Speed, Time, TestState, Legs);
 	}
 }
 
-void USmartCatAnimInstance::ExportGaitDataToCSV(float MinSpeed, float MaxSpeed, float SpeedStep, float TimeStep, float CycleDuration)
+FString USmartCatAnimInstance::BuildGaitSweepCSV(const FQuadrupedGaitConfig& Config, float MinSpeed, float MaxSpeed, float SpeedStep, float TimeStep, float CycleDuration)
 {
-	// Build CSV content
-	FString CSVContent;
+	if (SpeedStep <= 0.0f || TimeStep <= 0.0f)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SmartCatAI: Gait sweep needs a positive SpeedStep and TimeStep"));
+		return FString();
+	}
 
-	// Header
-	CSVContent += TEXT("Speed,Time,Gait,Phase,");
-	CSVContent += TEXT("FL_Phase,FL_Swinging,FL_SwingProgress,FL_LiftHeight,FL_StrideOffset,");
-	CSVContent += TEXT("FR_Phase,FR_Swinging,FR_SwingProgress,FR_LiftHeight,FR_StrideOffset,");
-	CSVContent += TEXT("BL_Phase,BL_Swinging,BL_SwingProgress,BL_LiftHeight,BL_StrideOffset,");
-	CSVContent += TEXT("BR_Phase,BR_Swinging,BR_SwingProgress,BR_LiftHeight,BR_StrideOffset\n");
-
-	// Iterate through speeds
-	for (float Speed = MinSpeed; Speed <= MaxSpeed; Speed += SpeedStep)
-	{
-		// Create a fresh gait state for this speed
-		FQuadrupedGaitState TestState;
-		FVector TestVelocity = FVector(Speed, 0, 0); // Forward velocity
-		FVector MoveDir = FVector(1, 0, 0);
-
-		// Simulate for CycleDuration seconds
-		for (float Time = 0.0f; Time < CycleDuration; Time += TimeStep)
-		{
-			// Update gait state
-			UQuadrupedGaitCalculator::UpdateGaitState(TestState, GaitConfig, TestVelocity, TimeStep);
-
-			// Calculate leg outputs
-			FQuadrupedLegGaitOutput FL = UQuadrupedGaitCalculator::CalculateFrontLeftLeg(TestState, GaitConfig, MoveDir);
-			FQuadrupedLegGaitOutput FR = UQuadrupedGaitCalculator::CalculateFrontRightLeg(TestState, GaitConfig, MoveDir);
-			FQuadrupedLegGaitOutput BL = UQuadrupedGaitCalculator::CalculateBackLeftLeg(TestState, GaitConfig, MoveDir);
-			FQuadrupedLegGaitOutput BR = UQuadrupedGaitCalculator::CalculateBackRightLeg(TestState, GaitConfig, MoveDir);
-
-			// Get gait name
-			FString GaitName;
-			switch (TestState.DetectedGait)
+	static const TCHAR* GaitNames[] = { TEXT("Stroll"), TEXT("Walk"), TEXT("Trot"), TEXT("Gallop") };
+
+	// Each speed is simulated independently into its own preallocated buffer
+	const TArray<float> Speeds = SmartCatAnimInstance::GetSweepSpeeds(MinSpeed, MaxSpeed, SpeedStep);
+	const int32 RowsPerSpeed = FMath::CeilToInt(CycleDuration / TimeStep) + 1;
+	TArray<FString> SpeedRows;
+	SpeedRows.SetNum(Speeds.Num());
+
+	ParallelFor(Speeds.Num(), [&](int32 SpeedIndex)
+	{
+		FString& Rows = SpeedRows[SpeedIndex];
+		Rows.Reserve(RowsPerSpeed * SmartCatAnimInstance::GaitCSVRowReserve);
+
+		SweepGaitAtSpeed(Config, Speeds[SpeedIndex], TimeStep, CycleDuration,
+			[&Rows](float Speed, float Time, const FQuadrupedGaitState& TestState, const FQuadrupedLegGaitOutput (&Legs)[EQuadrupedLeg::Num])
 			{
-			case EQuadrupedGait::Stroll: GaitName = TEXT("Stroll"); break;
-			case EQuadrupedGait::Walk: GaitName = TEXT("Walk"); break;
-			case EQuadrupedGait::Trot: GaitName = TEXT("Trot"); break;
-			case EQuadrupedGait::Gallop: GaitName = TEXT("Gallop"); break;
-			default: GaitName = TEXT("Unknown"); break;
-			}
+				const uint8 GaitIndex = static_cast<uint8>(TestState.DetectedGait);
+				const TCHAR* GaitName = GaitIndex < UE_ARRAY_COUNT(GaitNames) ? GaitNames[GaitIndex] : TEXT("Unknown");
+
+				Rows.Appendf(TEXT("%.1f,%.3f,%s,%.3f,"), Speed, Time, GaitName, TestState.GaitCyclePhase);
+
+				// FL, FR, BL, BR data
+				for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+				{
+					const FQuadrupedLegGaitOutput& Output = Legs[Leg];
+					Rows.Appendf(TEXT("%.3f,%d,%.3f,%.2f,%.2f"),
+						Output.StepPhase, Output.bIsSwinging ? 1 : 0, Output.SwingProgress, Output.LiftHeight, Output.StrideOffset);
+					Rows.AppendChar(Leg + 1 < EQuadrupedLeg::Num ? TEXT(',') : TEXT('\n'));
+				}
+			});
+	});
+
+	// Header
+	FString CSVContent = TEXT("Speed,Time,Gait,Phase,")
+		TEXT("FL_Phase,FL_Swinging,FL_SwingProgress,FL_LiftHeight,FL_StrideOffset,")
+		TEXT("FR_Phase,FR_Swinging,FR_SwingProgress,FR_LiftHeight,FR_StrideOffset,")
+		TEXT("BL_Phase,BL_Swinging,BL_SwingProgress,BL_LiftHeight,BL_StrideOffset,")
+		TEXT("BR_Phase,BR_Swinging,BR_SwingProgress,BR_LiftHeight,BR_StrideOffset\n");
+
+	// Concatenate in speed order
+	int32 TotalLength = CSVContent.Len();
+	for (const FString& Rows : SpeedRows)
+	{
+		TotalLength += Rows.Len();
+	}
+	CSVContent.Reserve(TotalLength);
+	for (const FString& Rows : SpeedRows)
+	{
+		CSVContent += Rows;
+	}
+	return CSVContent;
+}
 
-			// Write row
-			CSVContent += FString::Printf(TEXT("%.1f,%.3f,%s,%.3f,"),
-				Speed, Time, *GaitName, TestState.GaitCyclePhase);
+bool USmartCatAnimInstance::WriteGaitSweepTrace(const FQuadrupedGaitConfig& Config, float MinSpeed, float MaxSpeed, float SpeedStep, float TimeStep, float CycleDuration, const FString& FilePath)
+{
+	if (SpeedStep <= 0.0f || TimeStep <= 0.0f)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SmartCatAI: Gait sweep needs a positive SpeedStep and TimeStep"));
+		return false;
+	}
 
-			// FL data
-			CSVContent += FString::Printf(TEXT("%.3f,%d,%.3f,%.2f,%.2f,"),
-				FL.StepPhase, FL.bIsSwinging ? 1 : 0, FL.SwingProgress, FL.LiftHeight, FL.StrideOffset);
+	// Same columns as the CSV sweep; gait is stored as its enum value
+	static const TCHAR* LegPrefixes[EQuadrupedLeg::Num] = { TEXT("FL"), TEXT("FR"), TEXT("BL"), TEXT("BR") };
 
-			// FR data
-			CSVContent += FString::Printf(TEXT("%.3f,%d,%.3f,%.2f,%.2f,"),
-				FR.StepPhase, FR.bIsSwinging ? 1 : 0, FR.SwingProgress, FR.LiftHeight, FR.StrideOffset);
+	TArray<FSmartCatTraceColumn> Schema;
+	Schema.Add({ TEXT("Speed"), ESmartCatTraceColumnType::Float32 });
+	Schema.Add({ TEXT("Time"), ESmartCatTraceColumnType::Float32 });
+	Schema.Add({ TEXT("Gait"), ESmartCatTraceColumnType::UInt8 });
+	Schema.Add({ TEXT("Phase"), ESmartCatTraceColumnType::Float32 });
+	for (const TCHAR* Prefix : LegPrefixes)
+	{
+		Schema.Add({ FString::Printf(TEXT("%s_Phase"), Prefix), ESmartCatTraceColumnType::Float32 });
+		Schema.Add({ FString::Printf(TEXT("%s_Swinging"), Prefix), ESmartCatTraceColumnType::UInt8 });
+		Schema.Add({ FString::Printf(TEXT("%s_SwingProgress"), Prefix), ESmartCatTraceColumnType::Float32 });
+		Schema.Add({ FString::Printf(TEXT("%s_LiftHeight"), Prefix), ESmartCatTraceColumnType::Float32 });
+		Schema.Add({ FString::Printf(TEXT("%s_StrideOffset"), Prefix), ESmartCatTraceColumnType::Float32 });
+	}
 
-			// BL data
-			CSVContent += FString::Printf(TEXT("%.3f,%d,%.3f,%.2f,%.2f,"),
-				BL.StepPhase, BL.bIsSwinging ? 1 : 0, BL.SwingProgress, BL.LiftHeight, BL.StrideOffset);
+	FSmartCatTraceWriter Writer(MoveTemp(Schema));
+	if (!Writer.Open(FilePath))
+	{
+		return false;
+	}
 
-			// BR data
-			CSVContent += FString::Printf(TEXT("%.3f,%d,%.3f,%.2f,%.2f\n"),
-				BR.StepPhase, BR.bIsSwinging ? 1 : 0, BR.SwingProgress, BR.LiftHeight, BR.StrideOffset);
-		}
+	// The writer streams rows in order, so speeds run serially here
+	for (const float SweepSpeed : SmartCatAnimInstance::GetSweepSpeeds(MinSpeed, MaxSpeed, SpeedStep))
+	{
+		SweepGaitAtSpeed(Config, SweepSpeed, TimeStep, CycleDuration,
+			[&Writer](float Speed, float Time, const FQuadrupedGaitState& TestState, const FQuadrupedLegGaitOutput (&Legs)[EQuadrupedLeg::Num])
+			{
+				Writer.AddFloat(Speed);
+				Writer.AddFloat(Time);
+				Writer.AddUInt8(static_cast<uint8>(TestState.DetectedGait));
+				Writer.AddFloat(TestState.GaitCyclePhase);
+				for (const FQuadrupedLegGaitOutput& Leg : Legs)
+				{
+					Writer.AddFloat(Leg.StepPhase);
+					Writer.AddUInt8(Leg.bIsSwinging ? 1 : 0);
+					Writer.AddFloat(Leg.SwingProgress);
+					Writer.AddFloat(Leg.LiftHeight);
+					Writer.AddFloat(Leg.StrideOffset);
+				}
+				Writer.EndRow();
+			});
 	}
 
+	Writer.Close();
+	return true;
+}
+
+void USmartCatAnimInstance::ExportGaitDataToCSV(float MinSpeed, float MaxSpeed, float SpeedStep, float TimeStep, float CycleDuration)
+{
+	const FString CSVContent = BuildGaitSweepCSV(GaitConfig, MinSpeed, MaxSpeed, SpeedStep, TimeStep, CycleDuration);
+
 	// Write to file
 	FString FilePath = FPaths::ProjectSavedDir() / TEXT("GaitData.csv");
-	if (FFileHelper::SaveStringToFile(CSVContent, *FilePath))
+	if (!CSVContent.IsEmpty() && FFileHelper::SaveStringToFile(CSVContent, *FilePath))
+	{
+		UE_LOG(LogTemp, Log, TEXT("Gait data exported to: %s"), *FilePath);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to export gait data to: %s"), *FilePath);
+	}
+}
+
+void USmartCatAnimInstance::ExportGaitDataToTrace(float MinSpeed, float MaxSpeed, float SpeedStep, float TimeStep, float CycleDuration)
+{
+	const FString FilePath = FPaths::ProjectSavedDir() / TEXT("GaitData.sctrace");
+	if (WriteGaitSweepTrace(GaitConfig, MinSpeed, MaxSpeed, SpeedStep, TimeStep, CycleDuration, FilePath))
 	{
 		UE_LOG(LogTemp, Log, TEXT("Gait data exported to: %s"), *FilePath);
 	}
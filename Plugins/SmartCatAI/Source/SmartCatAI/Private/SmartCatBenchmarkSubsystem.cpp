@@ -0,0 +1,452 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SmartCatBenchmarkSubsystem.h"
+#include "SmartCatAIStats.h"
+#include "SmartCatAICharacter.h"
+#include "SmartCatAnimInstance.h"
+#include "SmartCatAIController.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "CoreGlobals.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace SmartCatBenchmark
+{
+	/** Edge length of one terrain tile (cm) */
+	static constexpr float TileSize = 400.0f;
+
+	/** Ground area per cat (cm); the patch grows with the crowd */
+	static constexpr float AreaPerCat = 300.0f;
+
+	/** Max height offset and tilt of a terrain tile */
+	static constexpr float MaxTileHeight = 40.0f;
+	static constexpr float MaxTileTilt = 8.0f;
+
+	/** Scripted movement: seconds between heading changes, and input scale range (sets the gait mix) */
+	static constexpr float MinTurnSeconds = 1.5f;
+	static constexpr float MaxTurnSeconds = 4.0f;
+	static constexpr float MinInputScale = 0.25f;
+
+	/** Query extent when checking that a spawn point is on the navmesh (cats spawn above the tiles) */
+	static const FVector NavProjectExtent(50.0f, 50.0f, 300.0f);
+
+	static float GetHalfExtent(int32 NumCats)
+	{
+		return FMath::Max(1000.0f, AreaPerCat * FMath::Sqrt(static_cast<float>(NumCats)));
+	}
+
+	/** Nearest-rank percentile of Values (sorted copy) */
+	static double Percentile(TArray<double> Values, double Fraction)
+	{
+		if (Values.Num() == 0)
+		{
+			return 0.0;
+		}
+		Values.Sort();
+		const int32 Rank = FMath::Clamp(FMath::CeilToInt(Fraction * Values.Num()) - 1, 0, Values.Num() - 1);
+		return Values[Rank];
+	}
+
+	static double Average(const TArray<double>& Values)
+	{
+		double Sum = 0.0;
+		for (const double Value : Values)
+		{
+			Sum += Value;
+		}
+		return Values.Num() > 0 ? Sum / Values.Num() : 0.0;
+	}
+
+	/** SmartCat.Benchmark Class=<path> [Cats=64] [Frames=600] [Warmup=60] [Seed=1234] [IKLOD] [Exit] */
+	static FAutoConsoleCommandWithWorldAndArgs BenchmarkCommand(
+		TEXT("SmartCat.Benchmark"),
+		TEXT("Run the headless cat-crowd benchmark in the current world and write JSON to Saved/SmartCatBenchmark/. ")
+		TEXT("Arguments: Class=<cat Blueprint class path> Cats=N Frames=N Warmup=N Seed=N IKLOD Exit"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+		{
+			USmartCatBenchmarkSubsystem* Benchmark = World ? World->GetSubsystem<USmartCatBenchmarkSubsystem>() : nullptr;
+			if (!Benchmark)
+			{
+				UE_LOG(LogTemp, Error, TEXT("SmartCatAI: Benchmark needs a game world"));
+				return;
+			}
+
+			FSmartCatBenchmarkSettings Settings;
+			const FString Params = FString::Join(Args, TEXT(" "));
+			FParse::Value(*Params, TEXT("Cats="), Settings.NumCats);
+			FParse::Value(*Params, TEXT("Frames="), Settings.NumFrames);
+			FParse::Value(*Params, TEXT("Warmup="), Settings.WarmupFrames);
+			FParse::Value(*Params, TEXT("Seed="), Settings.Seed);
+			Settings.bExitWhenDone = Args.ContainsByPredicate([](const FString& Arg) { return Arg.Equals(TEXT("Exit"), ESearchCase::IgnoreCase); });
+			Settings.bEnableIKLOD = Args.ContainsByPredicate([](const FString& Arg) { return Arg.Equals(TEXT("IKLOD"), ESearchCase::IgnoreCase); });
+
+			FString ClassPath;
+			if (!FParse::Value(*Params, TEXT("Class="), ClassPath))
+			{
+				UE_LOG(LogTemp, Error, TEXT("SmartCatAI: Benchmark needs Class=<cat Blueprint class path> (a cat with a mesh and a SmartCatAnimInstance)"));
+				return;
+			}
+			Settings.CatClass = LoadClass<ASmartCatAICharacter>(nullptr, *ClassPath);
+			if (!Settings.CatClass)
+			{
+				UE_LOG(LogTemp, Error, TEXT("SmartCatAI: Benchmark cat class %s not found"), *ClassPath);
+				return;
+			}
+
+			Benchmark->StartBenchmark(Settings);
+		}));
+}
+
+bool USmartCatBenchmarkSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USmartCatBenchmarkSubsystem::Deinitialize()
+{
+	if (bRunning)
+	{
+		Cleanup();
+	}
+
+	Super::Deinitialize();
+}
+
+TStatId USmartCatBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USmartCatBenchmarkSubsystem, STATGROUP_SmartCatAI);
+}
+
+bool USmartCatBenchmarkSubsystem::StartBenchmark(const FSmartCatBenchmarkSettings& InSettings)
+{
+	if (bRunning)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SmartCatAI: Benchmark already running"));
+		return false;
+	}
+
+	// The native class has no mesh or anim class, so it would measure nothing
+	if (!InSettings.CatClass)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SmartCatAI: Benchmark needs a cat class"));
+		return false;
+	}
+
+	Settings = InSettings;
+	Settings.NumCats = FMath::Max(1, Settings.NumCats);
+	Settings.NumFrames = FMath::Max(1, Settings.NumFrames);
+	Settings.WarmupFrames = FMath::Max(0, Settings.WarmupFrames);
+	LastReportPath.Reset();
+	LastMeasuredFrames = 0;
+	LastAverageCatSpeed = 0.0;
+
+	// Fixed timestep so every run simulates the same frames
+	bPrevUseFixedTimeStep = FApp::UseFixedTimeStep();
+	PrevFixedDeltaTime = FApp::GetFixedDeltaTime();
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(Settings.FixedDeltaTime);
+
+	FRandomStream Random(Settings.Seed);
+	SpawnTerrain(Random);
+	if (!SpawnCats(Random))
+	{
+		Cleanup();
+		return false;
+	}
+
+	// Without navmesh under them the wander task fails and the cats would stand still for the whole run
+	bScriptedMovement = !HasNavigationForCats();
+	MoveRandom.Initialize(Settings.Seed);
+
+	GameThreadMs.Reset(Settings.NumFrames);
+	AnimMs.Reset(Settings.NumFrames);
+	TracesPerFrame.Reset(Settings.NumFrames);
+	CatSpeed.Reset(Settings.NumFrames);
+	FrameIndex = 0;
+	bRunning = true;
+
+	SmartCatAIStats::BenchmarkAnimCycles = 0;
+	SmartCatAIStats::BenchmarkNumTraces = 0;
+	SmartCatAIStats::bCollectBenchmarkCounters = true;
+
+	UE_LOG(LogTemp, Log, TEXT("SmartCatAI: Benchmark started - %d cats (%s), %d warm-up + %d measured frames, IK LOD %s, %s movement"),
+		Settings.NumCats, *Settings.CatClass->GetName(), Settings.WarmupFrames, Settings.NumFrames,
+		Settings.bEnableIKLOD ? TEXT("on") : TEXT("off"), bScriptedMovement ? TEXT("scripted") : TEXT("navigation"));
+	return true;
+}
+
+void USmartCatBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!bRunning)
+	{
+		return;
+	}
+
+	// Anim and trace totals cover everything since the last tick; game thread time is the last full frame
+	const uint64 AnimCycles = SmartCatAIStats::BenchmarkAnimCycles.exchange(0);
+	const uint32 NumTraces = SmartCatAIStats::BenchmarkNumTraces.exchange(0);
+
+	if (bScriptedMovement)
+	{
+		DriveCats(DeltaTime);
+	}
+
+	if (FrameIndex++ < Settings.WarmupFrames)
+	{
+		return;
+	}
+
+	GameThreadMs.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+	AnimMs.Add(FPlatformTime::ToMilliseconds64(AnimCycles));
+	TracesPerFrame.Add(NumTraces);
+	CatSpeed.Add(MeasureCatSpeed());
+
+	if (GameThreadMs.Num() >= Settings.NumFrames)
+	{
+		FinishBenchmark();
+	}
+}
+
+void USmartCatBenchmarkSubsystem::SpawnTerrain(FRandomStream& Random)
+{
+	UWorld* World = GetWorld();
+	UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!CubeMesh)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SmartCatAI: Benchmark terrain mesh not found, cats use the existing level"));
+		return;
+	}
+
+	// Grid of tilted, height-jittered slabs: uneven but walkable
+	const float HalfExtent = SmartCatBenchmark::GetHalfExtent(Settings.NumCats);
+	const int32 TilesPerSide = FMath::CeilToInt(2.0f * HalfExtent / SmartCatBenchmark::TileSize);
+	const FVector TileScale(SmartCatBenchmark::TileSize / 100.0f, SmartCatBenchmark::TileSize / 100.0f, 1.0f);
+
+	for (int32 Y = 0; Y < TilesPerSide; ++Y)
+	{
+		for (int32 X = 0; X < TilesPerSide; ++X)
+		{
+			const FVector Location(
+				-HalfExtent + (X + 0.5f) * SmartCatBenchmark::TileSize,
+				-HalfExtent + (Y + 0.5f) * SmartCatBenchmark::TileSize,
+				Random.FRandRange(0.0f, SmartCatBenchmark::MaxTileHeight) - 50.0f);
+			const FRotator Rotation(
+				Random.FRandRange(-SmartCatBenchmark::MaxTileTilt, SmartCatBenchmark::MaxTileTilt),
+				0.0f,
+				Random.FRandRange(-SmartCatBenchmark::MaxTileTilt, SmartCatBenchmark::MaxTileTilt));
+
+			AStaticMeshActor* Tile = World->SpawnActor<AStaticMeshActor>(Location, Rotation);
+			if (!Tile)
+			{
+				continue;
+			}
+			UStaticMeshComponent* TileMesh = Tile->GetStaticMeshComponent();
+			TileMesh->SetMobility(EComponentMobility::Movable);
+			TileMesh->SetStaticMesh(CubeMesh);
+			Tile->SetActorScale3D(TileScale);
+			SpawnedActors.Add(Tile);
+		}
+	}
+}
+
+bool USmartCatBenchmarkSubsystem::SpawnCats(FRandomStream& Random)
+{
+	UWorld* World = GetWorld();
+	const float HalfExtent = SmartCatBenchmark::GetHalfExtent(Settings.NumCats) - SmartCatBenchmark::TileSize;
+
+	for (int32 Index = 0; Index < Settings.NumCats; ++Index)
+	{
+		const FTransform SpawnTransform(
+			FRotator(0.0f, Random.FRandRange(0.0f, 360.0f), 0.0f),
+			FVector(Random.FRandRange(-HalfExtent, HalfExtent), Random.FRandRange(-HalfExtent, HalfExtent), 150.0f));
+
+		ASmartCatAICharacter* Cat = World->SpawnActorDeferred<ASmartCatAICharacter>(
+			Settings.CatClass, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+		if (!Cat)
+		{
+			UE_LOG(LogTemp, Error, TEXT("SmartCatAI: Benchmark failed to spawn %s"), *Settings.CatClass->GetName());
+			return false;
+		}
+
+		// Always driven by the cat controller (and its behavior tree)
+		if (!Cat->AIControllerClass || !Cat->AIControllerClass->IsChildOf(ASmartCatAIController::StaticClass()))
+		{
+			Cat->AIControllerClass = ASmartCatAIController::StaticClass();
+		}
+		Cat->AutoPossessAI = EAutoPossessAI::Spawned;
+		Cat->FinishSpawning(SpawnTransform);
+
+		SpawnedActors.Add(Cat);
+		Cats.AddDefaulted_GetRef().Cat = Cat;
+		if (AController* CatController = Cat->GetController())
+		{
+			SpawnedActors.Add(CatController);
+		}
+
+		USmartCatAnimInstance* AnimInstance = Cat->GetMesh() ? Cast<USmartCatAnimInstance>(Cat->GetMesh()->GetAnimInstance()) : nullptr;
+		if (!AnimInstance)
+		{
+			UE_LOG(LogTemp, Error, TEXT("SmartCatAI: Benchmark cat class %s has no SmartCatAnimInstance (set CatSkeletalMesh and CatAnimClass)"),
+				*Settings.CatClass->GetName());
+			return false;
+		}
+
+		// Nothing renders under -nullrhi, so off-screen LOD would switch IK off for every cat
+		AnimInstance->SetIKLODEnabled(Settings.bEnableIKLOD);
+	}
+
+	return true;
+}
+
+bool USmartCatBenchmarkSubsystem::HasNavigationForCats() const
+{
+	UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld());
+	if (!NavSys)
+	{
+		return false;
+	}
+
+	for (const FCrowdCat& Entry : Cats)
+	{
+		const ASmartCatAICharacter* Cat = Entry.Cat.Get();
+		if (!Cat)
+		{
+			continue;
+		}
+
+		const FVector Location = Cat->GetActorLocation();
+		const ANavigationData* NavData = NavSys->GetNavDataForProps(Cat->GetNavAgentPropertiesRef(), Location);
+		FNavLocation Projected;
+		if (!NavData || !NavSys->ProjectPointToNavigation(Location, Projected, SmartCatBenchmark::NavProjectExtent, NavData))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void USmartCatBenchmarkSubsystem::DriveCats(float DeltaTime)
+{
+	// Turn back towards the middle before leaving the tiles
+	const float TurnBackExtent = SmartCatBenchmark::GetHalfExtent(Settings.NumCats) - SmartCatBenchmark::TileSize;
+
+	for (FCrowdCat& Entry : Cats)
+	{
+		ASmartCatAICharacter* Cat = Entry.Cat.Get();
+		if (!Cat)
+		{
+			continue;
+		}
+
+		const FVector Location = Cat->GetActorLocation();
+		const bool bOutside = FMath::Abs(Location.X) > TurnBackExtent || FMath::Abs(Location.Y) > TurnBackExtent;
+
+		Entry.SecondsUntilTurn -= DeltaTime;
+		if (Entry.SecondsUntilTurn <= 0.0f || bOutside)
+		{
+			const float Yaw = bOutside
+				? FMath::RadiansToDegrees(FMath::Atan2(-Location.Y, -Location.X)) + MoveRandom.FRandRange(-30.0f, 30.0f)
+				: MoveRandom.FRandRange(0.0f, 360.0f);
+			Entry.Heading = FRotator(0.0f, Yaw, 0.0f).Vector();
+			Entry.InputScale = MoveRandom.FRandRange(SmartCatBenchmark::MinInputScale, 1.0f);
+			Entry.SecondsUntilTurn = MoveRandom.FRandRange(SmartCatBenchmark::MinTurnSeconds, SmartCatBenchmark::MaxTurnSeconds);
+		}
+
+		Cat->AddMovementInput(Entry.Heading, Entry.InputScale);
+	}
+}
+
+double USmartCatBenchmarkSubsystem::MeasureCatSpeed() const
+{
+	double SpeedSum = 0.0;
+	int32 NumLiveCats = 0;
+	for (const FCrowdCat& Entry : Cats)
+	{
+		if (const ASmartCatAICharacter* Cat = Entry.Cat.Get())
+		{
+			SpeedSum += Cat->GetVelocity().Size2D();
+			++NumLiveCats;
+		}
+	}
+	return NumLiveCats > 0 ? SpeedSum / NumLiveCats : 0.0;
+}
+
+void USmartCatBenchmarkSubsystem::FinishBenchmark()
+{
+	const double AvgGameThread = SmartCatBenchmark::Average(GameThreadMs);
+	const double P99GameThread = SmartCatBenchmark::Percentile(GameThreadMs, 0.99);
+	const double AvgAnim = SmartCatBenchmark::Average(AnimMs);
+	const double P99Anim = SmartCatBenchmark::Percentile(AnimMs, 0.99);
+	const double AvgTraces = SmartCatBenchmark::Average(TracesPerFrame);
+	const double P99Traces = SmartCatBenchmark::Percentile(TracesPerFrame, 0.99);
+	const double AvgCatSpeed = SmartCatBenchmark::Average(CatSpeed);
+
+	FString Json;
+	Json += TEXT("{\n");
+	Json += FString::Printf(TEXT("\t\"cats\": %d,\n"), Settings.NumCats);
+	Json += FString::Printf(TEXT("\t\"catClass\": \"%s\",\n"), *Settings.CatClass->GetPathName());
+	Json += FString::Printf(TEXT("\t\"frames\": %d,\n"), GameThreadMs.Num());
+	Json += FString::Printf(TEXT("\t\"warmupFrames\": %d,\n"), Settings.WarmupFrames);
+	Json += FString::Printf(TEXT("\t\"fixedDeltaTime\": %.6f,\n"), Settings.FixedDeltaTime);
+	Json += FString::Printf(TEXT("\t\"seed\": %d,\n"), Settings.Seed);
+	Json += FString::Printf(TEXT("\t\"ikLOD\": %s,\n"), Settings.bEnableIKLOD ? TEXT("true") : TEXT("false"));
+	Json += FString::Printf(TEXT("\t\"buildConfiguration\": \"%s\",\n"), LexToString(FApp::GetBuildConfiguration()));
+	Json += FString::Printf(TEXT("\t\"movement\": \"%s\",\n"), bScriptedMovement ? TEXT("scripted") : TEXT("navigation"));
+	Json += FString::Printf(TEXT("\t\"avgCatSpeed\": %.2f,\n"), AvgCatSpeed);
+	Json += FString::Printf(TEXT("\t\"gameThreadMs\": { \"avg\": %.4f, \"p99\": %.4f },\n"), AvgGameThread, P99GameThread);
+	Json += FString::Printf(TEXT("\t\"animMs\": { \"avg\": %.4f, \"p99\": %.4f },\n"), AvgAnim, P99Anim);
+	Json += FString::Printf(TEXT("\t\"tracesPerFrame\": { \"avg\": %.2f, \"p99\": %.0f }\n"), AvgTraces, P99Traces);
+	Json += TEXT("}\n");
+
+	const FString FilePath = FPaths::ProjectSavedDir() / TEXT("SmartCatBenchmark")
+		/ FString::Printf(TEXT("Benchmark-%d-%s.json"), Settings.NumCats, *FDateTime::Now().ToString());
+	LastMeasuredFrames = GameThreadMs.Num();
+	LastAverageCatSpeed = AvgCatSpeed;
+	if (FFileHelper::SaveStringToFile(Json, *FilePath))
+	{
+		LastReportPath = FilePath;
+		UE_LOG(LogTemp, Log, TEXT("SmartCatAI: Benchmark written to %s\n%s"), *FilePath, *Json);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("SmartCatAI: Failed to write benchmark to %s"), *FilePath);
+	}
+
+	const bool bExit = Settings.bExitWhenDone;
+	Cleanup();
+
+	if (bExit)
+	{
+		FPlatformMisc::RequestExit(false, TEXT("SmartCatBenchmark"));
+	}
+}
+
+void USmartCatBenchmarkSubsystem::Cleanup()
+{
+	SmartCatAIStats::bCollectBenchmarkCounters = false;
+
+	for (AActor* Actor : SpawnedActors)
+	{
+		if (IsValid(Actor))
+		{
+			Actor->Destroy();
+		}
+	}
+	SpawnedActors.Empty();
+	Cats.Empty();
+
+	FApp::SetUseFixedTimeStep(bPrevUseFixedTimeStep);
+	FApp::SetFixedDeltaTime(PrevFixedDeltaTime);
+
+	bRunning = false;
+}
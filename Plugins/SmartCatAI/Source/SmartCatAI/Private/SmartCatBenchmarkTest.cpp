@@ -0,0 +1,159 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SmartCatBenchmarkSubsystem.h"
+#include "SmartCatAICharacter.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/App.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SmartCatBenchmarkTest
+{
+	/** Cat spawned unless -SmartCatBenchmarkClass=<path> is on the command line */
+	static const TCHAR* DefaultCatClassPath = TEXT("/SmartCatAI/Blueprints/BP_SmartCatAI.BP_SmartCatAI_C");
+
+	/** Small crowd and short run: this checks the pipeline, CI runs the full console command for numbers */
+	static constexpr int32 NumCats = 8;
+	static constexpr int32 NumFrames = 60;
+	static constexpr int32 WarmupFrames = 10;
+
+	/** World ticks allowed beyond warm-up + measured frames before the run counts as stuck */
+	static constexpr int32 TickSlack = 30;
+
+	/** Average cat ground speed (cm/s) below which the run measured idle cats */
+	static constexpr double MinCatSpeed = 10.0;
+
+	struct FState
+	{
+		TWeakObjectPtr<UWorld> World;
+		int32 NumTicks = 0;
+	};
+
+	static UWorld* CreateWorld()
+	{
+		UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("SmartCatBenchmarkTest"));
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+		return World;
+	}
+
+	static void DestroyWorld(UWorld* World)
+	{
+		if (World)
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+	}
+
+	static USmartCatBenchmarkSubsystem* GetBenchmark(const FState& State)
+	{
+		UWorld* World = State.World.Get();
+		return World ? World->GetSubsystem<USmartCatBenchmarkSubsystem>() : nullptr;
+	}
+}
+
+/** Tick the test world once per engine frame until the benchmark finishes or runs out of ticks */
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FSmartCatBenchmarkTickCommand, TSharedRef<SmartCatBenchmarkTest::FState>, State);
+
+bool FSmartCatBenchmarkTickCommand::Update()
+{
+	UWorld* World = State->World.Get();
+	USmartCatBenchmarkSubsystem* Benchmark = SmartCatBenchmarkTest::GetBenchmark(*State);
+	if (!World || !Benchmark || !Benchmark->IsRunning())
+	{
+		return true;
+	}
+
+	const int32 MaxTicks = SmartCatBenchmarkTest::WarmupFrames + SmartCatBenchmarkTest::NumFrames + SmartCatBenchmarkTest::TickSlack;
+	if (State->NumTicks++ >= MaxTicks)
+	{
+		return true;
+	}
+
+	World->Tick(LEVELTICK_All, FApp::GetFixedDeltaTime());
+	return false;
+}
+
+/** Check the report, then tear the world down */
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FSmartCatBenchmarkVerifyCommand, FAutomationTestBase*, Test, TSharedRef<SmartCatBenchmarkTest::FState>, State);
+
+bool FSmartCatBenchmarkVerifyCommand::Update()
+{
+	if (USmartCatBenchmarkSubsystem* Benchmark = SmartCatBenchmarkTest::GetBenchmark(*State))
+	{
+		if (Benchmark->IsRunning())
+		{
+			Test->AddError(FString::Printf(TEXT("Benchmark still running after %d world ticks"), State->NumTicks));
+		}
+		else
+		{
+			const FString& ReportPath = Benchmark->GetLastReportPath();
+			if (ReportPath.IsEmpty() || IFileManager::Get().FileSize(*ReportPath) <= 0)
+			{
+				Test->AddError(TEXT("Benchmark wrote no JSON report"));
+			}
+			if (Benchmark->GetLastMeasuredFrames() <= 0)
+			{
+				Test->AddError(TEXT("Benchmark measured no frames"));
+			}
+			if (Benchmark->GetLastAverageCatSpeed() < SmartCatBenchmarkTest::MinCatSpeed)
+			{
+				Test->AddError(FString::Printf(TEXT("Cats did not move (average speed %.2f cm/s)"), Benchmark->GetLastAverageCatSpeed()));
+			}
+		}
+	}
+	else
+	{
+		Test->AddError(TEXT("Benchmark world went away during the run"));
+	}
+
+	SmartCatBenchmarkTest::DestroyWorld(State->World.Get());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSmartCatBenchmarkCrowdTest, "SmartCatAI.Benchmark.CatCrowd",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FSmartCatBenchmarkCrowdTest::RunTest(const FString& Parameters)
+{
+	FString ClassPath = SmartCatBenchmarkTest::DefaultCatClassPath;
+	FParse::Value(FCommandLine::Get(), TEXT("SmartCatBenchmarkClass="), ClassPath);
+
+	FSmartCatBenchmarkSettings Settings;
+	Settings.NumCats = SmartCatBenchmarkTest::NumCats;
+	Settings.NumFrames = SmartCatBenchmarkTest::NumFrames;
+	Settings.WarmupFrames = SmartCatBenchmarkTest::WarmupFrames;
+	Settings.CatClass = LoadClass<ASmartCatAICharacter>(nullptr, *ClassPath);
+	if (!Settings.CatClass)
+	{
+		AddError(FString::Printf(TEXT("Cat class %s not found (pass -SmartCatBenchmarkClass=<path>)"), *ClassPath));
+		return false;
+	}
+
+	TSharedRef<SmartCatBenchmarkTest::FState> State = MakeShared<SmartCatBenchmarkTest::FState>();
+	UWorld* World = SmartCatBenchmarkTest::CreateWorld();
+	State->World = World;
+
+	USmartCatBenchmarkSubsystem* Benchmark = World->GetSubsystem<USmartCatBenchmarkSubsystem>();
+	if (!Benchmark || !Benchmark->StartBenchmark(Settings))
+	{
+		AddError(TEXT("Benchmark failed to start"));
+		SmartCatBenchmarkTest::DestroyWorld(World);
+		return false;
+	}
+
+	ADD_LATENT_AUTOMATION_COMMAND(FSmartCatBenchmarkTickCommand(State));
+	ADD_LATENT_AUTOMATION_COMMAND(FSmartCatBenchmarkVerifyCommand(this, State));
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,153 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SmartCatGaitSubsystem.h"
+#include "SmartCatAIStats.h"
+
+void USmartCatGaitSubsystem::Deinitialize()
+{
+	RequestSlots.Empty();
+	RequestStates.Empty();
+	RequestConfigs.Empty();
+	RequestVelocities.Empty();
+	RequestMoveDirections.Empty();
+	RequestDeltaTimes.Empty();
+	RequestLegOutputs.Empty();
+	States.Empty();
+	LegOutputs.Empty();
+	SlotActive.Empty();
+	SlotEvaluated.Empty();
+	SlotRequest.Empty();
+	FreeSlots.Empty();
+
+	Super::Deinitialize();
+}
+
+void USmartCatGaitSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Results only count for the batch that produced them
+	for (bool& bEvaluated : SlotEvaluated)
+	{
+		bEvaluated = false;
+	}
+
+	if (RequestSlots.Num() == 0)
+	{
+		return;
+	}
+
+	RequestLegOutputs.SetNum(RequestSlots.Num(), EAllowShrinking::No);
+	UQuadrupedGaitCalculator::UpdateGaitStateBatch(RequestStates, RequestConfigs, RequestVelocities, RequestMoveDirections,
+		RequestDeltaTimes, RequestLegOutputs);
+
+	for (int32 Request = 0; Request < RequestSlots.Num(); ++Request)
+	{
+		// Unregistered after submitting
+		const int32 Slot = RequestSlots[Request];
+		if (Slot == INDEX_NONE)
+		{
+			continue;
+		}
+
+		States[Slot] = RequestStates[Request];
+		LegOutputs[Slot] = RequestLegOutputs[Request];
+		SlotEvaluated[Slot] = true;
+		SlotRequest[Slot] = INDEX_NONE;
+	}
+
+	RequestSlots.Reset();
+	RequestStates.Reset();
+	RequestConfigs.Reset();
+	RequestVelocities.Reset();
+	RequestMoveDirections.Reset();
+	RequestDeltaTimes.Reset();
+}
+
+TStatId USmartCatGaitSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USmartCatGaitSubsystem, STATGROUP_SmartCatAI);
+}
+
+int32 USmartCatGaitSubsystem::RegisterCat()
+{
+	int32 Slot;
+	if (FreeSlots.Num() > 0)
+	{
+		Slot = FreeSlots.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		Slot = States.AddDefaulted();
+		LegOutputs.AddDefaulted();
+		SlotActive.Add(false);
+		SlotEvaluated.Add(false);
+		SlotRequest.Add(INDEX_NONE);
+	}
+
+	SlotActive[Slot] = true;
+	SlotEvaluated[Slot] = false;
+	SlotRequest[Slot] = INDEX_NONE;
+
+	return Slot;
+}
+
+void USmartCatGaitSubsystem::UnregisterCat(int32 Slot)
+{
+	if (!SlotActive.IsValidIndex(Slot) || !SlotActive[Slot])
+	{
+		return;
+	}
+
+	// Drop a request still waiting for the batch so its result isn't written to a reused slot
+	if (SlotRequest[Slot] != INDEX_NONE)
+	{
+		RequestSlots[SlotRequest[Slot]] = INDEX_NONE;
+		SlotRequest[Slot] = INDEX_NONE;
+	}
+
+	SlotActive[Slot] = false;
+	SlotEvaluated[Slot] = false;
+	FreeSlots.Add(Slot);
+}
+
+void USmartCatGaitSubsystem::SetCatInput(int32 Slot, const FQuadrupedGaitState& State, const FQuadrupedGaitConfig& Config,
+	const FVector& Velocity, const FVector& MoveDirection, float DeltaTime)
+{
+	if (!SlotActive.IsValidIndex(Slot) || !SlotActive[Slot])
+	{
+		return;
+	}
+
+	int32& Request = SlotRequest[Slot];
+	if (Request == INDEX_NONE)
+	{
+		Request = RequestSlots.Add(Slot);
+		RequestStates.AddDefaulted();
+		RequestConfigs.AddDefaulted();
+		RequestVelocities.AddDefaulted();
+		RequestMoveDirections.AddDefaulted();
+		RequestDeltaTimes.AddDefaulted();
+	}
+
+	RequestStates[Request] = State;
+	RequestConfigs[Request] = Config;
+	RequestVelocities[Request] = Velocity;
+	RequestMoveDirections[Request] = MoveDirection;
+	RequestDeltaTimes[Request] = DeltaTime;
+}
+
+bool USmartCatGaitSubsystem::GetCatOutput(int32 Slot, FQuadrupedGaitState& OutState, FQuadrupedLegGaitOutput (&OutLegs)[EQuadrupedLeg::Num]) const
+{
+	if (!SlotEvaluated.IsValidIndex(Slot) || !SlotEvaluated[Slot])
+	{
+		return false;
+	}
+
+	OutState = States[Slot];
+	for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+	{
+		OutLegs[Leg] = LegOutputs[Slot].Legs[Leg];
+	}
+	return true;
+}
@@ -0,0 +1,65 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SmartCatGaitSweepCommandlet.h"
+#include "SmartCatAnimInstance.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+USmartCatGaitSweepCommandlet::USmartCatGaitSweepCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 USmartCatGaitSweepCommandlet::Main(const FString& Params)
+{
+	float MinSpeed = 0.0f;
+	float MaxSpeed = 500.0f;
+	float SpeedStep = 25.0f;
+	float TimeStep = 0.016f;
+	float CycleDuration = 2.0f;
+	FParse::Value(*Params, TEXT("minspeed="), MinSpeed);
+	FParse::Value(*Params, TEXT("maxspeed="), MaxSpeed);
+	FParse::Value(*Params, TEXT("speedstep="), SpeedStep);
+	FParse::Value(*Params, TEXT("timestep="), TimeStep);
+	FParse::Value(*Params, TEXT("duration="), CycleDuration);
+
+	FString OutPath = FPaths::ProjectSavedDir() / TEXT("GaitData.csv");
+	FParse::Value(*Params, TEXT("out="), OutPath);
+
+	// Use the tuned config of an anim Blueprint when one is given
+	FQuadrupedGaitConfig Config;
+	FString AnimClassPath;
+	if (FParse::Value(*Params, TEXT("animclass="), AnimClassPath))
+	{
+		UClass* AnimClass = LoadObject<UClass>(nullptr, *AnimClassPath);
+		if (!AnimClass || !AnimClass->IsChildOf(USmartCatAnimInstance::StaticClass()))
+		{
+			UE_LOG(LogTemp, Error, TEXT("SmartCatAI: %s is not a SmartCatAnimInstance class"), *AnimClassPath);
+			return 1;
+		}
+		Config = GetDefault<USmartCatAnimInstance>(AnimClass)->GaitConfig;
+	}
+
+	bool bSuccess = false;
+	if (FPaths::GetExtension(OutPath) == TEXT("sctrace"))
+	{
+		bSuccess = USmartCatAnimInstance::WriteGaitSweepTrace(Config, MinSpeed, MaxSpeed, SpeedStep, TimeStep, CycleDuration, OutPath);
+	}
+	else
+	{
+		const FString CSVContent = USmartCatAnimInstance::BuildGaitSweepCSV(Config, MinSpeed, MaxSpeed, SpeedStep, TimeStep, CycleDuration);
+		bSuccess = !CSVContent.IsEmpty() && FFileHelper::SaveStringToFile(CSVContent, *OutPath);
+	}
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SmartCatAI: Failed to write gait table to %s"), *OutPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("SmartCatAI: Gait table written to %s"), *OutPath);
+	return 0;
+}
@@ -0,0 +1,104 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SmartCatIKFlightRecorder.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformFileManager.h"
+
+void FSmartCatIKFlightRecorder::Initialize(int32 InCapacity)
+{
+	Capacity = FMath::Max(InCapacity, 0);
+	Slots = Capacity > 0 ? MakeUnique<FSlot[]>(Capacity) : nullptr;
+	WriteIndex.store(0, std::memory_order_relaxed);
+}
+
+void FSmartCatIKFlightRecorder::Record(const FSmartCatIKFlightFrame& Frame)
+{
+	if (Capacity == 0)
+	{
+		return;
+	}
+
+	const uint64 Index = WriteIndex.load(std::memory_order_relaxed);
+	FSlot& Slot = Slots[Index % Capacity];
+
+	// Odd sequence marks the slot as being written
+	const uint32 Sequence = Slot.Sequence.load(std::memory_order_relaxed);
+	Slot.Sequence.store(Sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	Slot.Frame = Frame;
+
+	Slot.Sequence.store(Sequence + 2, std::memory_order_release);
+	WriteIndex.store(Index + 1, std::memory_order_release);
+}
+
+int32 FSmartCatIKFlightRecorder::Snapshot(TArray<FSmartCatIKFlightFrame>& OutFrames) const
+{
+	OutFrames.Reset();
+	if (Capacity == 0)
+	{
+		return 0;
+	}
+
+	const uint64 End = WriteIndex.load(std::memory_order_acquire);
+	const uint64 Begin = End > static_cast<uint64>(Capacity) ? End - Capacity : 0;
+	OutFrames.Reserve(static_cast<int32>(End - Begin));
+
+	for (uint64 Index = Begin; Index < End; ++Index)
+	{
+		const FSlot& Slot = Slots[Index % Capacity];
+
+		const uint32 SequenceBefore = Slot.Sequence.load(std::memory_order_acquire);
+		if (SequenceBefore & 1)
+		{
+			continue;
+		}
+
+		const FSmartCatIKFlightFrame Frame = Slot.Frame;
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		// Overwritten while we were copying it
+		if (Slot.Sequence.load(std::memory_order_relaxed) != SequenceBefore)
+		{
+			continue;
+		}
+
+		OutFrames.Add(Frame);
+	}
+
+	return OutFrames.Num();
+}
+
+bool FSmartCatIKFlightRecorder::WriteCsv(const FString& Path, const FString& Reason, TConstArrayView<FSmartCatIKFlightFrame> Frames)
+{
+	static const TCHAR* LegNames[EQuadrupedLeg::Num] = { TEXT("FL"), TEXT("FR"), TEXT("BL"), TEXT("BR") };
+
+	FString Csv;
+	Csv.Reserve((Frames.Num() + 2) * 200);
+
+	Csv += FString::Printf(TEXT("# %s\n"), *Reason);
+	Csv += TEXT("Time,Speed,GaitPhase,Gait,IKMode,IKLOD,SlopePitch,SlopeRoll,PelvisOffsetZ,Anomalies");
+	for (const TCHAR* Leg : LegNames)
+	{
+		Csv += FString::Printf(TEXT(",%s_PawZ,%s_GroundZ,%s_FootOffset,%s_Residual,%s_Alpha"), Leg, Leg, Leg, Leg, Leg);
+	}
+	Csv += TEXT("\n");
+
+	for (const FSmartCatIKFlightFrame& Frame : Frames)
+	{
+		Csv += FString::Printf(TEXT("%.3f,%.1f,%.3f,%d,%d,%d,%.2f,%.2f,%.2f,%d"),
+			Frame.Time, Frame.GroundSpeed, Frame.GaitPhase, Frame.Gait, Frame.IKMode, Frame.IKLOD,
+			Frame.SlopePitch, Frame.SlopeRoll, Frame.PelvisOffsetZ, Frame.Anomalies);
+
+		for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+		{
+			Csv += FString::Printf(TEXT(",%.2f,%.2f,%.2f,%.2f,%.2f"),
+				Frame.PawZ[Leg], Frame.GroundZ[Leg], Frame.FootOffset[Leg], Frame.ResidualOffset[Leg], Frame.IKAlpha[Leg]);
+		}
+		Csv += TEXT("\n");
+	}
+
+	FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*FPaths::GetPath(Path));
+	return FFileHelper::SaveStringToFile(Csv, *Path);
+}
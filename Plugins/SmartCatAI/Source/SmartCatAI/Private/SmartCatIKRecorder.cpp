@@ -0,0 +1,188 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SmartCatIKRecorder.h"
+#include "SmartCatTraceFile.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "Async/Async.h"
+
+namespace SmartCatIKRecorder
+{
+	static const TCHAR* PointNames[FSmartCatIKDebugRow::NumPoints] =
+	{
+		TEXT("FL"), TEXT("FR"), TEXT("BL"), TEXT("BR"), TEXT("Bell"), TEXT("Jaw")
+	};
+
+	/** Same columns as the old text recording: Time, Speed, then Z/GroundZ/Diff per point */
+	static TArray<FSmartCatTraceColumn> MakeSchema()
+	{
+		TArray<FSmartCatTraceColumn> Schema;
+		Schema.Emplace(TEXT("Time"), ESmartCatTraceColumnType::Float32);
+		Schema.Emplace(TEXT("Speed"), ESmartCatTraceColumnType::Float32);
+		for (const TCHAR* Name : PointNames)
+		{
+			Schema.Emplace(FString::Printf(TEXT("%s_Z"), Name), ESmartCatTraceColumnType::Float32);
+			Schema.Emplace(FString::Printf(TEXT("%s_GroundZ"), Name), ESmartCatTraceColumnType::Float32);
+			Schema.Emplace(FString::Printf(TEXT("%s_Diff"), Name), ESmartCatTraceColumnType::Float32);
+		}
+		return Schema;
+	}
+}
+
+FSmartCatIKRecorder::FSmartCatIKRecorder()
+{
+	FlushEvent = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+FSmartCatIKRecorder::~FSmartCatIKRecorder()
+{
+	StopRecording();
+	WaitForConversion();
+	FPlatformProcess::ReturnSynchEventToPool(FlushEvent);
+	FlushEvent = nullptr;
+}
+
+bool FSmartCatIKRecorder::StartRecording(const FString& InBinaryPath, const FString& InCsvPath)
+{
+	if (IsRecording())
+	{
+		return true;
+	}
+
+	// The conversion memory-maps the trace file; reopening it for write would truncate it under the mapping
+	WaitForConversion();
+
+	Writer = MakeUnique<FSmartCatTraceWriter>(SmartCatIKRecorder::MakeSchema());
+	if (!Writer->Open(InBinaryPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("SmartCatAI: Could not open %s for IK debug recording"), *InBinaryPath);
+		Writer.Reset();
+		return false;
+	}
+
+	BinaryPath = InBinaryPath;
+	CsvPath = InCsvPath;
+	PendingRows.Reset();
+	WritingRows.Reset();
+	bStopRequested = false;
+
+	Thread = FRunnableThread::Create(this, TEXT("SmartCatIKRecorder"), 0, TPri_BelowNormal);
+	return Thread != nullptr;
+}
+
+void FSmartCatIKRecorder::StopRecording()
+{
+	if (!Thread)
+	{
+		return;
+	}
+
+	// Writer thread drains the buffer before it exits
+	Stop();
+	Thread->WaitForCompletion();
+	delete Thread;
+	Thread = nullptr;
+
+	Writer->Close();
+	Writer.Reset();
+
+	// CSV formatting is the slow part; keep it off the game thread as well
+	ConversionResult = Async(EAsyncExecution::ThreadPool, [Binary = BinaryPath, Csv = CsvPath]()
+	{
+		const bool bConverted = ConvertBinaryToCsv(Binary, Csv);
+		if (bConverted)
+		{
+			UE_LOG(LogTemp, Log, TEXT("SmartCatAI: Wrote runtime IK debug CSV to %s"), *Csv);
+		}
+		return bConverted;
+	});
+}
+
+void FSmartCatIKRecorder::WaitForConversion()
+{
+	if (ConversionResult.IsValid())
+	{
+		ConversionResult.Wait();
+		ConversionResult.Reset();
+	}
+}
+
+void FSmartCatIKRecorder::AppendRow(const FSmartCatIKDebugRow& Row)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	bool bWakeWriter = false;
+	{
+		FScopeLock Lock(&PendingLock);
+		PendingRows.Add(Row);
+		bWakeWriter = PendingRows.Num() >= FlushRowThreshold;
+	}
+
+	if (bWakeWriter)
+	{
+		FlushEvent->Trigger();
+	}
+}
+
+uint32 FSmartCatIKRecorder::Run()
+{
+	while (!bStopRequested)
+	{
+		FlushEvent->Wait(FlushIntervalMs);
+		FlushPendingRows();
+	}
+
+	// Rows appended between the last wake-up and the stop request
+	FlushPendingRows();
+	return 0;
+}
+
+void FSmartCatIKRecorder::Stop()
+{
+	bStopRequested = true;
+	FlushEvent->Trigger();
+}
+
+void FSmartCatIKRecorder::FlushPendingRows()
+{
+	{
+		FScopeLock Lock(&PendingLock);
+		Swap(PendingRows, WritingRows);
+	}
+
+	if (WritingRows.Num() > 0 && Writer)
+	{
+		for (const FSmartCatIKDebugRow& Row : WritingRows)
+		{
+			Writer->AddFloat(Row.Time);
+			Writer->AddFloat(Row.Speed);
+			for (int32 Point = 0; Point < FSmartCatIKDebugRow::NumPoints; ++Point)
+			{
+				Writer->AddFloat(Row.BoneZ[Point]);
+				Writer->AddFloat(Row.GroundZ[Point]);
+				Writer->AddFloat(Row.BoneZ[Point] - Row.GroundZ[Point]);
+			}
+			Writer->EndRow();
+		}
+
+		// One row group per flush so a crash loses at most one flush interval
+		Writer->FlushRowGroup();
+	}
+	WritingRows.Reset();
+}
+
+bool FSmartCatIKRecorder::ConvertBinaryToCsv(const FString& InBinaryPath, const FString& InCsvPath)
+{
+	FSmartCatTraceReader Reader;
+	FString Error;
+	if (!Reader.Open(InBinaryPath, Error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("SmartCatAI: Could not read IK debug recording %s: %s"), *InBinaryPath, *Error);
+		return false;
+	}
+
+	return Reader.ConvertToCsv(InCsvPath);
+}
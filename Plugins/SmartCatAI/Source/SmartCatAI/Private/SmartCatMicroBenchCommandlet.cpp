@@ -0,0 +1,213 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SmartCatMicroBenchCommandlet.h"
+#include "QuadrupedGaitCalculator.h"
+#include "RigUnit_ClaudeQuadrupedIK.h"
+#include "SmartCatAnimInstance.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+
+namespace SmartCatMicroBench
+{
+	/** Number of precomputed inputs cycled through (power of two) */
+	static constexpr int32 NumInputs = 1024;
+
+	/** Cats per call in the gait batch benchmark */
+	static constexpr int32 BatchSize = 1024;
+
+	struct FResult
+	{
+		FString Name;
+		double NsPerOp = 0.0;
+	};
+
+	/** Results are folded into this so the optimizer cannot drop the benchmarked work */
+	static volatile float Sink = 0.0f;
+
+	/** Time Body(Index) over Iterations calls after a short warm-up; OpsPerCall scales to ns per single op */
+	template <typename BodyType>
+	static FResult Run(const TCHAR* Name, int32 Iterations, int32 OpsPerCall, BodyType&& Body)
+	{
+		for (int32 Index = 0; Index < Iterations / 10; ++Index)
+		{
+			Body(Index & (NumInputs - 1));
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < Iterations; ++Index)
+		{
+			Body(Index & (NumInputs - 1));
+		}
+		const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+		FResult Result;
+		Result.Name = Name;
+		Result.NsPerOp = Elapsed * 1.0e9 / (static_cast<double>(Iterations) * OpsPerCall);
+		return Result;
+	}
+
+	static TArray<FResult> RunAll(int32 Iterations)
+	{
+		FRandomStream Random(42);
+		const FQuadrupedGaitConfig Config;
+		const float DeltaTime = 1.0f / 60.0f;
+
+		// Inputs spread over every gait and some uneven ground
+		TArray<FVector> Velocities;
+		TArray<FVector> MoveDirections;
+		TArray<FQuadrupedGaitState> States;
+		TArray<FTransform> FootTransforms;
+		float GroundZ[NumInputs][EQuadrupedLeg::Num];
+		for (int32 Index = 0; Index < NumInputs; ++Index)
+		{
+			const FVector Direction = FVector(Random.FRandRange(-1.0f, 1.0f), Random.FRandRange(-1.0f, 1.0f), 0.0f).GetSafeNormal2D();
+			Velocities.Add(Direction * Random.FRandRange(0.0f, 300.0f));
+			MoveDirections.Add(Direction);
+
+			FQuadrupedGaitState State;
+			UQuadrupedGaitCalculator::UpdateGaitState(State, Config, Velocities.Last(), Random.FRandRange(0.0f, 1.0f));
+			States.Add(State);
+
+			FootTransforms.Add(FTransform(FRotator(0.0f, Random.FRandRange(0.0f, 360.0f), 0.0f), FVector(0.0f, 0.0f, Random.FRandRange(-20.0f, 20.0f))));
+			for (int32 Leg = 0; Leg < EQuadrupedLeg::Num; ++Leg)
+			{
+				GroundZ[Index][Leg] = Random.FRandRange(-15.0f, 15.0f);
+			}
+		}
+
+		TArray<FResult> Results;
+
+		Results.Add(Run(TEXT("UpdateGaitState"), Iterations, 1, [&](int32 Index)
+		{
+			FQuadrupedGaitState& State = States[Index];
+			UQuadrupedGaitCalculator::UpdateGaitState(State, Config, Velocities[Index], DeltaTime);
+			Sink = Sink + State.AccumulatedPhase;
+		}));
+
+		Results.Add(Run(TEXT("CalculateFrontLeftLeg"), Iterations, 1, [&](int32 Index)
+		{
+			const FQuadrupedLegGaitOutput Output = UQuadrupedGaitCalculator::CalculateFrontLeftLeg(States[Index], Config, MoveDirections[Index]);
+			Sink = Sink + Output.LiftHeight;
+		}));
+
+		Results.Add(Run(TEXT("CalculateAllLegs"), Iterations, 1, [&](int32 Index)
+		{
+			FQuadrupedLegGaitOutput Legs[EQuadrupedLeg::Num];
+			UQuadrupedGaitCalculator::CalculateAllLegs(States[Index], Config, MoveDirections[Index], Legs);
+			Sink = Sink + Legs[EQuadrupedLeg::BackRight].LiftHeight;
+		}));
+
+		Results.Add(Run(TEXT("CalculateAllLegsScalar"), Iterations, 1, [&](int32 Index)
+		{
+			FQuadrupedLegGaitOutput Legs[EQuadrupedLeg::Num];
+			UQuadrupedGaitCalculator::CalculateAllLegsScalar(States[Index], Config, MoveDirections[Index], Legs);
+			Sink = Sink + Legs[EQuadrupedLeg::BackRight].LiftHeight;
+		}));
+
+		{
+			// One call updates BatchSize cats; reported per cat
+			TArray<FQuadrupedGaitState> BatchStates = States;
+			TArray<FQuadrupedGaitConfig> BatchConfigs;
+			BatchConfigs.Init(Config, BatchSize);
+			TArray<float> BatchDeltaTimes;
+			BatchDeltaTimes.Init(DeltaTime, BatchSize);
+			TArray<FQuadrupedGaitLegOutputs> BatchOutputs;
+			BatchOutputs.SetNum(BatchSize);
+			static_assert(BatchSize == NumInputs, "Batch inputs reuse the per-cat input tables");
+
+			Results.Add(Run(TEXT("UpdateGaitStateBatch (per cat)"), FMath::Max(1, Iterations / BatchSize), BatchSize, [&](int32)
+			{
+				UQuadrupedGaitCalculator::UpdateGaitStateBatch(BatchStates, BatchConfigs, Velocities, MoveDirections, BatchDeltaTimes, BatchOutputs);
+				Sink = Sink + BatchOutputs[0].Legs[EQuadrupedLeg::FrontLeft].LiftHeight;
+			}));
+		}
+
+		Results.Add(Run(TEXT("ComputeSlopeAngles"), Iterations, 1, [&](int32 Index)
+		{
+			float AverageGroundZ;
+			float Pitch;
+			float Roll;
+			USmartCatAnimInstance::ComputeSlopeAngles(GroundZ[Index], 60.0f, 20.0f, 30.0f, 20.0f, AverageGroundZ, Pitch, Roll);
+			Sink = Sink + Pitch + Roll;
+		}));
+
+		Results.Add(Run(TEXT("ComputeSlopeResiduals"), Iterations, 1, [&](int32 Index)
+		{
+			float Residuals[EQuadrupedLeg::Num];
+			USmartCatAnimInstance::ComputeSlopeResiduals(GroundZ[Index], 0.0f, GroundZ[Index][0], GroundZ[Index][1], 60.0f, 20.0f, 2.0f, 30.0f, Residuals);
+			Sink = Sink + Residuals[EQuadrupedLeg::BackRight];
+		}));
+
+		Results.Add(Run(TEXT("RigUnit SolveLeg"), Iterations, 1, [&](int32 Index)
+		{
+			FClaudeQuadrupedLegSolveContext Context;
+			Context.AccumulatedPhase = States[Index].AccumulatedPhase;
+			Context.Speed = Velocities[Index].Size2D();
+			Context.MoveDirection = MoveDirections[Index];
+
+			const FTransform& FootTransform = FootTransforms[Index];
+			FVector HitPoint = FVector::ZeroVector;
+			const bool bHit = FRigUnit_ClaudeQuadrupedIK::TraceGroundPlane(
+				FootTransform.GetLocation() + FVector(0.0f, 0.0f, 50.0f), FootTransform.GetLocation() - FVector(0.0f, 0.0f, 75.0f), 0.0f, HitPoint);
+
+			FClaudeQuadrupedLegOutput Output;
+			Sink = Sink + FRigUnit_ClaudeQuadrupedIK::SolveLeg(Context, FootTransform, 0.25f, bHit, HitPoint, FVector::UpVector, Output);
+		}));
+
+		return Results;
+	}
+
+	static void LogResults(const TArray<FResult>& Results, int32 Iterations)
+	{
+		UE_LOG(LogTemp, Display, TEXT("SmartCatAI: Microbenchmarks (%d iterations)"), Iterations);
+		for (const FResult& Result : Results)
+		{
+			UE_LOG(LogTemp, Display, TEXT("SmartCatAI:   %-32s %10.2f ns/op"), *Result.Name, Result.NsPerOp);
+		}
+	}
+
+	/** SmartCat.MicroBench [Iterations]: run the microbenchmarks on the game thread */
+	static FAutoConsoleCommand MicroBenchCommand(
+		TEXT("SmartCat.MicroBench"),
+		TEXT("Run the SmartCatAI gait/IK math microbenchmarks and log ns/op. Optional argument: iterations (default 1000000)."),
+		FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+		{
+			const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000000;
+			LogResults(RunAll(Iterations), Iterations);
+		}));
+}
+
+USmartCatMicroBenchCommandlet::USmartCatMicroBenchCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 USmartCatMicroBenchCommandlet::Main(const FString& Params)
+{
+	int32 Iterations = 1000000;
+	FParse::Value(*Params, TEXT("iterations="), Iterations);
+	Iterations = FMath::Max(1, Iterations);
+
+	const TArray<SmartCatMicroBench::FResult> Results = SmartCatMicroBench::RunAll(Iterations);
+	SmartCatMicroBench::LogResults(Results, Iterations);
+
+	FString OutPath;
+	if (FParse::Value(*Params, TEXT("out="), OutPath))
+	{
+		FString Csv = TEXT("Benchmark,NsPerOp\n");
+		for (const SmartCatMicroBench::FResult& Result : Results)
+		{
+			Csv += FString::Printf(TEXT("%s,%.3f\n"), *Result.Name, Result.NsPerOp);
+		}
+		if (!FFileHelper::SaveStringToFile(Csv, *OutPath))
+		{
+			UE_LOG(LogTemp, Error, TEXT("SmartCatAI: Failed to write microbenchmark results to %s"), *OutPath);
+			return 1;
+		}
+	}
+
+	return 0;
+}
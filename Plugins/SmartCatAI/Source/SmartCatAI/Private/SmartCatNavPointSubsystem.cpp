@@ -0,0 +1,321 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SmartCatNavPointSubsystem.h"
+#include "SmartCatAIStats.h"
+#include "NavigationSystem.h"
+#include "NavMesh/RecastNavMesh.h"
+#include "Engine/World.h"
+
+namespace SmartCatNavPoints
+{
+	/** A point at least this far above the floor next to it is a perch (cm) */
+	static constexpr float PerchHeight = 50.0f;
+
+	/** Horizontal distance of the floor probes around a point (cm) */
+	static constexpr float PerchProbeDistance = 60.0f;
+
+	/** Floor probes start this far above the point, so a wall beside it blocks the start (cm) */
+	static constexpr float PerchProbeStartHeight = 20.0f;
+
+	/** Deepest drop a floor probe looks for below the point (cm) */
+	static constexpr float PerchProbeDepth = 500.0f;
+
+	/** Navmesh layers in one column closer than this are the same surface (cm) */
+	static constexpr float MinLayerSeparation = 30.0f;
+
+	/** Geometry closer than this overhead makes a hiding spot (cm) */
+	static constexpr float HidingClearance = 120.0f;
+}
+
+bool USmartCatNavPointSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USmartCatNavPointSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(&InWorld);
+	if (!NavSys)
+	{
+		return;
+	}
+
+	NavigationDirtyHandle = NavSys->NavigationDirtyEvent.AddUObject(this, &USmartCatNavPointSubsystem::HandleNavigationDirty);
+
+	// Initial fill; runs over the first frames within the per-tick budget
+	const FBox NavBounds = NavSys->GetNavigableWorldBounds();
+	if (NavBounds.IsValid)
+	{
+		SampleBounds = NavBounds;
+		QueueCellsInBounds(NavBounds);
+		UE_LOG(LogTemp, Log, TEXT("SmartCatAI: Nav point pool queued %d cells"), PendingCells.Num());
+	}
+}
+
+void USmartCatNavPointSubsystem::Deinitialize()
+{
+	if (UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld()))
+	{
+		NavSys->NavigationDirtyEvent.Remove(NavigationDirtyHandle);
+	}
+	NavigationDirtyHandle.Reset();
+
+	Cells.Empty();
+	PendingCells.Empty();
+	PendingCellSet.Empty();
+	NumPoints = 0;
+
+	Super::Deinitialize();
+}
+
+void USmartCatNavPointSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (PendingCells.Num() == 0)
+	{
+		return;
+	}
+
+	// Sample only finished tiles
+	const UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld());
+	if (!NavSys || NavSys->IsNavigationBuildInProgress())
+	{
+		return;
+	}
+
+	SMARTCATAI_SCOPE_CYCLE_COUNTER(STAT_SmartCatAI_NavPointPool);
+
+	const int32 NumToBuild = FMath::Min(MaxCellsPerTick, PendingCells.Num());
+	for (int32 Index = 0; Index < NumToBuild; ++Index)
+	{
+		RebuildCell(PendingCells[Index]);
+		PendingCellSet.Remove(PendingCells[Index]);
+	}
+	PendingCells.RemoveAt(0, NumToBuild, EAllowShrinking::No);
+
+	if (PendingCells.Num() == 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("SmartCatAI: Nav point pool ready (%d points in %d cells)"), NumPoints, Cells.Num());
+	}
+}
+
+TStatId USmartCatNavPointSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USmartCatNavPointSubsystem, STATGROUP_SmartCatAI);
+}
+
+void USmartCatNavPointSubsystem::HandleNavigationDirty(const FBox& DirtyBounds)
+{
+	if (DirtyBounds.IsValid)
+	{
+		SampleBounds += DirtyBounds;
+		QueueCellsInBounds(DirtyBounds);
+	}
+}
+
+void USmartCatNavPointSubsystem::QueueCellsInBounds(const FBox& Bounds)
+{
+	const FIntPoint MinCell = GetCellCoord(Bounds.Min);
+	const FIntPoint MaxCell = GetCellCoord(Bounds.Max);
+	for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+	{
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			const FIntPoint Cell(X, Y);
+			bool bAlreadyQueued = false;
+			PendingCellSet.Add(Cell, &bAlreadyQueued);
+			if (!bAlreadyQueued)
+			{
+				PendingCells.Add(Cell);
+			}
+		}
+	}
+}
+
+void USmartCatNavPointSubsystem::RebuildCell(const FIntPoint& Cell)
+{
+	const UNavigationSystemV1* NavSys = UNavigationSystemV1::GetCurrent(GetWorld());
+	if (!NavSys || !SampleBounds.IsValid)
+	{
+		return;
+	}
+
+	// Recast can return every layer in a column (floor, table, shelf); other nav data only the nearest
+	const ARecastNavMesh* NavMesh = Cast<ARecastNavMesh>(NavSys->GetNavDataForProps(FNavAgentProperties::DefaultProperties));
+
+	TArray<FSmartCatNavPoint> Points;
+	TArray<FNavLocation> Layers;
+
+	const int32 StepsPerCell = FMath::Max(1, FMath::RoundToInt(CellSize / PointSpacing));
+	const float SampleZ = SampleBounds.GetCenter().Z;
+	const FVector ProjectExtent(PointSpacing * 0.5f, PointSpacing * 0.5f, SampleBounds.GetExtent().Z + PointSpacing);
+
+	for (int32 StepY = 0; StepY < StepsPerCell; ++StepY)
+	{
+		for (int32 StepX = 0; StepX < StepsPerCell; ++StepX)
+		{
+			const FVector Sample(
+				(Cell.X * StepsPerCell + StepX + 0.5f) * PointSpacing,
+				(Cell.Y * StepsPerCell + StepY + 0.5f) * PointSpacing,
+				SampleZ);
+
+			Layers.Reset();
+			if (NavMesh)
+			{
+				// MinZ/MaxZ are absolute world heights (the query is re-centred between them)
+				NavMesh->ProjectPointMulti(Sample, Layers, ProjectExtent, SampleZ - ProjectExtent.Z, SampleZ + ProjectExtent.Z);
+			}
+			else
+			{
+				FNavLocation NavLocation;
+				if (NavSys->ProjectPointToNavigation(Sample, NavLocation, ProjectExtent))
+				{
+					Layers.Add(NavLocation);
+				}
+			}
+
+			// Neighbouring polys of one surface project to (almost) the same point; keep one per layer
+			Layers.Sort([](const FNavLocation& A, const FNavLocation& B) { return A.Location.Z < B.Location.Z; });
+			for (int32 Layer = 0; Layer < Layers.Num(); ++Layer)
+			{
+				const FVector& Location = Layers[Layer].Location;
+				if (Layer > 0 && Location.Z - Layers[Layer - 1].Location.Z < SmartCatNavPoints::MinLayerSeparation)
+				{
+					continue;
+				}
+
+				FSmartCatNavPoint& Point = Points.AddDefaulted_GetRef();
+				Point.Location = Location;
+				Point.Tags = ClassifyPoint(Location);
+			}
+		}
+	}
+
+	if (TArray<FSmartCatNavPoint>* Existing = Cells.Find(Cell))
+	{
+		NumPoints -= Existing->Num();
+	}
+	NumPoints += Points.Num();
+
+	if (Points.Num() > 0)
+	{
+		Cells.Add(Cell, MoveTemp(Points));
+	}
+	else
+	{
+		Cells.Remove(Cell);
+	}
+}
+
+ECatNavPointTag USmartCatNavPointSubsystem::ClassifyPoint(const FVector& Location) const
+{
+	using namespace SmartCatNavPoints;
+
+	UWorld* World = GetWorld();
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(SmartCatNavPointClassify), false);
+	FHitResult Hit;
+
+	ECatNavPointTag Tags = ECatNavPointTag::None;
+
+	// Something low overhead: hiding spot
+	const FVector Up = Location + FVector(0.0f, 0.0f, 5.0f);
+	if (World->LineTraceSingleByChannel(Hit, Up, Up + FVector(0.0f, 0.0f, HidingClearance), ECC_Visibility, Params))
+	{
+		Tags |= ECatNavPointTag::HidingSpot;
+	}
+
+	// Floor found well below on any side: perch. A probe starting inside geometry (a wall next
+	// to the point) or finding nothing within PerchProbeDepth says nothing about a drop.
+	static const FVector2D ProbeDirections[] = { { 1.0f, 0.0f }, { -1.0f, 0.0f }, { 0.0f, 1.0f }, { 0.0f, -1.0f } };
+	for (const FVector2D& Direction : ProbeDirections)
+	{
+		const FVector ProbeStart = Location + FVector(Direction * PerchProbeDistance, PerchProbeStartHeight);
+		if (World->OverlapBlockingTestByChannel(ProbeStart, FQuat::Identity, ECC_Visibility, FCollisionShape::MakeSphere(1.0f), Params))
+		{
+			continue;
+		}
+
+		const FVector ProbeEnd = FVector(ProbeStart.X, ProbeStart.Y, Location.Z - PerchProbeDepth);
+		if (World->LineTraceSingleByChannel(Hit, ProbeStart, ProbeEnd, ECC_Visibility, Params)
+			&& !Hit.bStartPenetrating
+			&& Hit.ImpactPoint.Z < Location.Z - PerchHeight)
+		{
+			Tags |= ECatNavPointTag::Perch;
+			break;
+		}
+	}
+
+	if (Tags == ECatNavPointTag::None)
+	{
+		Tags = ECatNavPointTag::OpenFloor;
+	}
+	return Tags;
+}
+
+const FSmartCatNavPoint* USmartCatNavPointSubsystem::ProbeRandomPoint(const FVector& Origin, float MinRadius, float MaxRadius) const
+{
+	const float Angle = FMath::FRandRange(0.0f, 2.0f * PI);
+	const float Distance = FMath::FRandRange(MinRadius, MaxRadius);
+	const FVector Probe = Origin + FVector(FMath::Cos(Angle) * Distance, FMath::Sin(Angle) * Distance, 0.0f);
+
+	const TArray<FSmartCatNavPoint>* Points = Cells.Find(GetCellCoord(Probe));
+	return Points ? &(*Points)[FMath::RandHelper(Points->Num())] : nullptr;
+}
+
+bool USmartCatNavPointSubsystem::FindWanderPoint(const FVector& Origin, float MinRadius, float MaxRadius, ECatNavPointTag RequiredTags, FVector& OutLocation) const
+{
+	const float MinRadiusSq = FMath::Square(MinRadius);
+	const float MaxRadiusSq = FMath::Square(MaxRadius);
+
+	for (int32 Try = 0; Try < MaxSampleTries; ++Try)
+	{
+		const FSmartCatNavPoint* Point = ProbeRandomPoint(Origin, MinRadius, MaxRadius);
+		if (!Point || (RequiredTags != ECatNavPointTag::None && !EnumHasAnyFlags(Point->Tags, RequiredTags)))
+		{
+			continue;
+		}
+
+		// The probe lands in the right ring but the cell's point may not
+		const float DistanceSq = FVector::DistSquared2D(Origin, Point->Location);
+		if (DistanceSq >= MinRadiusSq && DistanceSq <= MaxRadiusSq)
+		{
+			OutLocation = Point->Location;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool USmartCatNavPointSubsystem::FindEscapePoint(const FVector& Origin, const FVector& Threat, float MaxRadius, float MinThreatDistance, ECatNavPointTag RequiredTags, FVector& OutLocation) const
+{
+	const float MaxRadiusSq = FMath::Square(MaxRadius);
+	float BestThreatDistanceSq = FMath::Square(MinThreatDistance);
+	bool bFound = false;
+
+	for (int32 Try = 0; Try < MaxSampleTries; ++Try)
+	{
+		const FSmartCatNavPoint* Point = ProbeRandomPoint(Origin, 0.0f, MaxRadius);
+		if (!Point || (RequiredTags != ECatNavPointTag::None && !EnumHasAnyFlags(Point->Tags, RequiredTags))
+			|| FVector::DistSquared2D(Origin, Point->Location) > MaxRadiusSq)
+		{
+			continue;
+		}
+
+		const float ThreatDistanceSq = FVector::DistSquared2D(Threat, Point->Location);
+		if (ThreatDistanceSq >= BestThreatDistanceSq)
+		{
+			BestThreatDistanceSq = ThreatDistanceSq;
+			OutLocation = Point->Location;
+			bFound = true;
+		}
+	}
+	return bFound;
+}
+
+FIntPoint USmartCatNavPointSubsystem::GetCellCoord(const FVector& Location)
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
@@ -0,0 +1,84 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SmartCatTraceCommandlet.h"
+#include "SmartCatTraceFile.h"
+#include "Misc/Paths.h"
+
+USmartCatTraceCommandlet::USmartCatTraceCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 USmartCatTraceCommandlet::Main(const FString& Params)
+{
+	FString InPath;
+	if (!FParse::Value(*Params, TEXT("in="), InPath) || InPath.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("SmartCatAI: Usage: -run=SmartCatTrace -in=<file.sctrace> [-out=<path>] [-format=csv|columns] [-validate]"));
+		return 1;
+	}
+
+	FString Format = TEXT("csv");
+	FParse::Value(*Params, TEXT("format="), Format);
+	const bool bValidateOnly = FParse::Param(*Params, TEXT("validate"));
+
+	FSmartCatTraceReader Reader;
+	FString Error;
+	if (!Reader.Open(InPath, Error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("SmartCatAI: Invalid trace %s: %s"), *InPath, *Error);
+		return 1;
+	}
+
+	const int64 NonFinite = Reader.CountNonFiniteValues();
+	UE_LOG(LogTemp, Display, TEXT("SmartCatAI: %s - version %d, %d columns, %lld rows in %d row groups, %lld non-finite values"),
+		*InPath, Reader.GetVersion(), Reader.GetSchema().Num(), Reader.GetNumRows(), Reader.GetRowGroups().Num(), NonFinite);
+
+	if (bValidateOnly)
+	{
+		for (const FSmartCatTraceColumn& Column : Reader.GetSchema())
+		{
+			UE_LOG(LogTemp, Display, TEXT("SmartCatAI:   %s (%s)"), *Column.Name,
+				Column.Type == ESmartCatTraceColumnType::UInt8 ? TEXT("uint8") : TEXT("float32"));
+		}
+		return NonFinite > 0 ? 2 : 0;
+	}
+
+	FString OutPath;
+	FParse::Value(*Params, TEXT("out="), OutPath);
+
+	bool bSuccess = false;
+	if (Format == TEXT("columns"))
+	{
+		if (OutPath.IsEmpty())
+		{
+			OutPath = FPaths::GetPath(InPath) / FPaths::GetBaseFilename(InPath);
+		}
+		bSuccess = Reader.ConvertToColumnFiles(OutPath);
+	}
+	else if (Format == TEXT("csv"))
+	{
+		if (OutPath.IsEmpty())
+		{
+			OutPath = FPaths::ChangeExtension(InPath, TEXT("csv"));
+		}
+		bSuccess = Reader.ConvertToCsv(OutPath);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("SmartCatAI: Unknown -format=%s (expected csv or columns)"), *Format);
+		return 1;
+	}
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SmartCatAI: Failed to write %s"), *OutPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("SmartCatAI: Wrote %s"), *OutPath);
+	return 0;
+}
@@ -0,0 +1,427 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SmartCatTraceFile.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace SmartCatTrace
+{
+	static int64 Align(int64 Value, int64 Alignment)
+	{
+		return (Value + Alignment - 1) & ~(Alignment - 1);
+	}
+
+	static void WritePadding(IFileHandle& File, int64 Written, int64 Alignment)
+	{
+		static const uint8 Zeros[8] = {};
+		const int64 Padding = Align(Written, Alignment) - Written;
+		if (Padding > 0)
+		{
+			File.Write(Zeros, Padding);
+		}
+	}
+
+	/** Longest prefix of Utf8 (at most 255 bytes) that doesn't split a multi-byte character */
+	static uint8 GetNameLength(const FTCHARToUTF8& Utf8)
+	{
+		int32 Length = FMath::Min(Utf8.Length(), 255);
+		if (Length < Utf8.Length())
+		{
+			// Back off continuation bytes (10xxxxxx) to the start of the cut character
+			const uint8* Bytes = reinterpret_cast<const uint8*>(Utf8.Get());
+			while (Length > 0 && (Bytes[Length] & 0xC0) == 0x80)
+			{
+				--Length;
+			}
+		}
+		return static_cast<uint8>(Length);
+	}
+}
+
+// ============================================
+// Writer
+// ============================================
+
+FSmartCatTraceWriter::FSmartCatTraceWriter(TArray<FSmartCatTraceColumn> InSchema, int32 InRowGroupSize)
+	: Schema(MoveTemp(InSchema))
+	, RowGroupSize(FMath::Max(InRowGroupSize, 1))
+{
+	ColumnData.SetNum(Schema.Num());
+	for (int32 Column = 0; Column < Schema.Num(); ++Column)
+	{
+		ColumnData[Column].Reserve(RowGroupSize * Schema[Column].GetValueSize());
+	}
+}
+
+FSmartCatTraceWriter::~FSmartCatTraceWriter()
+{
+	Close();
+}
+
+bool FSmartCatTraceWriter::Open(const FString& Path)
+{
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Path));
+	FileHandle = PlatformFile.OpenWrite(*Path);
+	if (!FileHandle)
+	{
+		return false;
+	}
+
+	const uint32 Magic = SmartCatTrace::FileMagic;
+	const uint16 FileVersion = SmartCatTrace::CurrentVersion;
+	const uint16 NumColumns = static_cast<uint16>(Schema.Num());
+	int64 Written = 0;
+
+	FileHandle->Write(reinterpret_cast<const uint8*>(&Magic), sizeof(Magic));
+	FileHandle->Write(reinterpret_cast<const uint8*>(&FileVersion), sizeof(FileVersion));
+	FileHandle->Write(reinterpret_cast<const uint8*>(&NumColumns), sizeof(NumColumns));
+	Written += sizeof(Magic) + sizeof(FileVersion) + sizeof(NumColumns);
+
+	for (const FSmartCatTraceColumn& Column : Schema)
+	{
+		const FTCHARToUTF8 Name(*Column.Name);
+		const uint8 Type = static_cast<uint8>(Column.Type);
+		const uint8 NameLength = SmartCatTrace::GetNameLength(Name);
+
+		FileHandle->Write(&Type, 1);
+		FileHandle->Write(&NameLength, 1);
+		FileHandle->Write(reinterpret_cast<const uint8*>(Name.Get()), NameLength);
+		Written += 2 + NameLength;
+	}
+
+	SmartCatTrace::WritePadding(*FileHandle, Written, 8);
+	BufferedRows = 0;
+	NextColumn = 0;
+	return true;
+}
+
+void FSmartCatTraceWriter::Close()
+{
+	if (!FileHandle)
+	{
+		return;
+	}
+
+	FlushRowGroup();
+	delete FileHandle;
+	FileHandle = nullptr;
+}
+
+void FSmartCatTraceWriter::AddFloat(float Value)
+{
+	check(Schema.IsValidIndex(NextColumn) && Schema[NextColumn].Type == ESmartCatTraceColumnType::Float32);
+	ColumnData[NextColumn++].Append(reinterpret_cast<const uint8*>(&Value), sizeof(Value));
+}
+
+void FSmartCatTraceWriter::AddUInt8(uint8 Value)
+{
+	check(Schema.IsValidIndex(NextColumn) && Schema[NextColumn].Type == ESmartCatTraceColumnType::UInt8);
+	ColumnData[NextColumn++].Add(Value);
+}
+
+void FSmartCatTraceWriter::EndRow()
+{
+	check(NextColumn == Schema.Num());
+	NextColumn = 0;
+
+	if (++BufferedRows >= RowGroupSize)
+	{
+		FlushRowGroup();
+	}
+}
+
+void FSmartCatTraceWriter::FlushRowGroup()
+{
+	if (!FileHandle || BufferedRows == 0)
+	{
+		return;
+	}
+
+	const uint32 Magic = SmartCatTrace::RowGroupMagic;
+	const uint32 NumRows = static_cast<uint32>(BufferedRows);
+	FileHandle->Write(reinterpret_cast<const uint8*>(&Magic), sizeof(Magic));
+	FileHandle->Write(reinterpret_cast<const uint8*>(&NumRows), sizeof(NumRows));
+
+	for (TArray<uint8>& Column : ColumnData)
+	{
+		FileHandle->Write(Column.GetData(), Column.Num());
+		SmartCatTrace::WritePadding(*FileHandle, Column.Num(), 4);
+		Column.Reset();
+	}
+
+	BufferedRows = 0;
+
+	// Push the group to the OS so a crash keeps every group flushed so far
+	FileHandle->Flush();
+}
+
+// ============================================
+// Reader
+// ============================================
+
+FSmartCatTraceReader::~FSmartCatTraceReader()
+{
+	delete MappedRegion;
+	delete MappedHandle;
+}
+
+bool FSmartCatTraceReader::Open(const FString& Path, FString& OutError)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	// Map the file when the platform supports it; otherwise read it in
+	MappedHandle = PlatformFile.OpenMapped(*Path);
+	if (MappedHandle && MappedHandle->GetFileSize() > 0)
+	{
+		MappedRegion = MappedHandle->MapRegion(0, MappedHandle->GetFileSize());
+	}
+
+	if (MappedRegion)
+	{
+		Data = MappedRegion->GetMappedPtr();
+		DataSize = MappedRegion->GetMappedSize();
+	}
+	else
+	{
+		if (!FFileHelper::LoadFileToArray(LoadedData, *Path))
+		{
+			OutError = FString::Printf(TEXT("Could not read %s"), *Path);
+			return false;
+		}
+		Data = LoadedData.GetData();
+		DataSize = LoadedData.Num();
+	}
+
+	return Parse(OutError);
+}
+
+bool FSmartCatTraceReader::Parse(FString& OutError)
+{
+	int64 Offset = 0;
+	auto Read = [this, &Offset](void* Dest, int64 Size)
+	{
+		if (Offset + Size > DataSize)
+		{
+			return false;
+		}
+		FMemory::Memcpy(Dest, Data + Offset, Size);
+		Offset += Size;
+		return true;
+	};
+
+	uint32 Magic = 0;
+	uint16 NumColumns = 0;
+	if (!Read(&Magic, sizeof(Magic)) || !Read(&Version, sizeof(Version)) || !Read(&NumColumns, sizeof(NumColumns)))
+	{
+		OutError = TEXT("File too small for a header");
+		return false;
+	}
+	if (Magic != SmartCatTrace::FileMagic)
+	{
+		OutError = TEXT("Not a SmartCat trace file (bad magic)");
+		return false;
+	}
+	if (Version == 0 || Version > SmartCatTrace::CurrentVersion)
+	{
+		OutError = FString::Printf(TEXT("Unsupported version %d (this build reads up to %d)"), Version, SmartCatTrace::CurrentVersion);
+		return false;
+	}
+
+	Schema.Reset(NumColumns);
+	for (int32 Column = 0; Column < NumColumns; ++Column)
+	{
+		uint8 Type = 0;
+		uint8 NameLength = 0;
+		if (!Read(&Type, 1) || !Read(&NameLength, 1) || Offset + NameLength > DataSize)
+		{
+			OutError = FString::Printf(TEXT("Header truncated in column %d"), Column);
+			return false;
+		}
+		if (Type > static_cast<uint8>(ESmartCatTraceColumnType::UInt8))
+		{
+			OutError = FString::Printf(TEXT("Column %d has unknown type %d"), Column, Type);
+			return false;
+		}
+
+		const FUTF8ToTCHAR Name(reinterpret_cast<const UTF8CHAR*>(Data + Offset), NameLength);
+		Schema.Emplace(FString(Name.Length(), Name.Get()), static_cast<ESmartCatTraceColumnType>(Type));
+		Offset += NameLength;
+	}
+	Offset = SmartCatTrace::Align(Offset, 8);
+
+	// A recording cut short (crash, full disk) ends in a partial row group; keep everything before it
+	auto WarnTruncated = [this](int64 GroupOffset)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SmartCatAI: Trace ends in a partial row group at offset %lld; dropped its %lld bytes, kept %d complete row groups"),
+			GroupOffset, DataSize - GroupOffset, RowGroups.Num());
+	};
+
+	RowGroups.Reset();
+	while (Offset < DataSize)
+	{
+		const int64 GroupOffset = Offset;
+		uint32 GroupMagic = 0;
+		uint32 NumRows = 0;
+		if (!Read(&GroupMagic, sizeof(GroupMagic)) || !Read(&NumRows, sizeof(NumRows)))
+		{
+			WarnTruncated(GroupOffset);
+			break;
+		}
+		if (GroupMagic != SmartCatTrace::RowGroupMagic)
+		{
+			OutError = FString::Printf(TEXT("Bad row group header at offset %lld"), GroupOffset);
+			return false;
+		}
+
+		FRowGroup Group;
+		Group.NumRows = static_cast<int32>(NumRows);
+		for (const FSmartCatTraceColumn& Column : Schema)
+		{
+			const int64 ColumnSize = static_cast<int64>(NumRows) * Column.GetValueSize();
+			if (Offset + ColumnSize > DataSize)
+			{
+				break;
+			}
+			Group.Columns.Add(Data + Offset);
+			Offset = SmartCatTrace::Align(Offset + ColumnSize, 4);
+		}
+
+		if (Group.Columns.Num() < Schema.Num())
+		{
+			WarnTruncated(GroupOffset);
+			break;
+		}
+		RowGroups.Add(MoveTemp(Group));
+	}
+
+	return true;
+}
+
+int64 FSmartCatTraceReader::GetNumRows() const
+{
+	int64 NumRows = 0;
+	for (const FRowGroup& Group : RowGroups)
+	{
+		NumRows += Group.NumRows;
+	}
+	return NumRows;
+}
+
+float FSmartCatTraceReader::GetFloat(const FRowGroup& Group, int32 Column, int32 Row) const
+{
+	float Value;
+	FMemory::Memcpy(&Value, Group.Columns[Column] + Row * sizeof(float), sizeof(float));
+	return Value;
+}
+
+uint8 FSmartCatTraceReader::GetUInt8(const FRowGroup& Group, int32 Column, int32 Row) const
+{
+	return Group.Columns[Column][Row];
+}
+
+int64 FSmartCatTraceReader::CountNonFiniteValues() const
+{
+	int64 NonFinite = 0;
+	for (const FRowGroup& Group : RowGroups)
+	{
+		for (int32 Column = 0; Column < Schema.Num(); ++Column)
+		{
+			if (Schema[Column].Type != ESmartCatTraceColumnType::Float32)
+			{
+				continue;
+			}
+			for (int32 Row = 0; Row < Group.NumRows; ++Row)
+			{
+				NonFinite += FMath::IsFinite(GetFloat(Group, Column, Row)) ? 0 : 1;
+			}
+		}
+	}
+	return NonFinite;
+}
+
+bool FSmartCatTraceReader::ConvertToCsv(const FString& CsvPath) const
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(CsvPath));
+	TUniquePtr<IFileHandle> File(PlatformFile.OpenWrite(*CsvPath));
+	if (!File)
+	{
+		return false;
+	}
+
+	// Written one row group at a time to keep memory flat on long recordings
+	auto WriteText = [&File](const FString& Text)
+	{
+		const FTCHARToUTF8 Utf8(*Text);
+		File->Write(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	};
+
+	FString Text;
+	for (int32 Column = 0; Column < Schema.Num(); ++Column)
+	{
+		Text += Column > 0 ? TEXT(",") : TEXT("");
+		Text += Schema[Column].Name;
+	}
+	Text += TEXT("\n");
+	WriteText(Text);
+
+	for (const FRowGroup& Group : RowGroups)
+	{
+		Text.Reset();
+		for (int32 Row = 0; Row < Group.NumRows; ++Row)
+		{
+			for (int32 Column = 0; Column < Schema.Num(); ++Column)
+			{
+				if (Column > 0)
+				{
+					Text += TEXT(",");
+				}
+				if (Schema[Column].Type == ESmartCatTraceColumnType::Float32)
+				{
+					Text += FString::Printf(TEXT("%.9g"), GetFloat(Group, Column, Row));
+				}
+				else
+				{
+					Text.AppendInt(GetUInt8(Group, Column, Row));
+				}
+			}
+			Text += TEXT("\n");
+		}
+		WriteText(Text);
+	}
+
+	return true;
+}
+
+bool FSmartCatTraceReader::ConvertToColumnFiles(const FString& Directory) const
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*Directory);
+
+	FString SchemaText = FString::Printf(TEXT("version=%d\nrows=%lld\n"), Version, GetNumRows());
+	for (int32 Column = 0; Column < Schema.Num(); ++Column)
+	{
+		const FSmartCatTraceColumn& Info = Schema[Column];
+		const FString FileName = FString::Printf(TEXT("%03d_%s.bin"), Column, *Info.Name);
+		SchemaText += FString::Printf(TEXT("%s,%s,%s\n"), *Info.Name,
+			Info.Type == ESmartCatTraceColumnType::Float32 ? TEXT("float32") : TEXT("uint8"), *FileName);
+
+		// Concatenate the column across row groups into one contiguous array
+		TUniquePtr<IFileHandle> File(PlatformFile.OpenWrite(*(Directory / FileName)));
+		if (!File)
+		{
+			return false;
+		}
+		for (const FRowGroup& Group : RowGroups)
+		{
+			File->Write(Group.Columns[Column], static_cast<int64>(Group.NumRows) * Info.GetValueSize());
+		}
+	}
+
+	return FFileHelper::SaveStringToFile(SchemaText, *(Directory / TEXT("schema.txt")));
+}
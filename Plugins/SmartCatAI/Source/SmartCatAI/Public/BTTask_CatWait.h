@@ -4,11 +4,23 @@
 
 #include "CoreMinimal.h"
 #include "BehaviorTree/BTTaskNode.h"
+#include "Engine/TimerHandle.h"
 #include "SmartCatAnimInstance.h"
 #include "BTTask_CatWait.generated.h"
 
+/** Per-cat runtime state of UBTTask_CatWait, stored in the behavior tree's node memory */
+struct FBTCatWaitTaskMemory
+{
+	/** Fires when the wait is over */
+	FTimerHandle WaitTimerHandle;
+
+	/** Fires at the next idle action chance */
+	FTimerHandle IdleActionTimerHandle;
+};
+
 /**
  * Behavior Tree Task: Make the cat wait/idle with optional random actions
+ * Driven by timers; the task does not tick
  */
 UCLASS()
 class SMARTCATAI_API UBTTask_CatWait : public UBTTaskNode
@@ -19,7 +31,11 @@ public:
 	UBTTask_CatWait();
 
 	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
-	virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+	virtual void OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult) override;
+	virtual uint16 GetInstanceMemorySize() const override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+	virtual void CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const override;
+	virtual void DescribeRuntimeValues(const UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTDescriptionVerbosity::Type Verbosity, TArray<FString>& Values) const override;
 	virtual FString GetStaticDescription() const override;
 
 protected:
@@ -40,9 +56,12 @@ protected:
 	TArray<ECatAnimationAction> PossibleIdleActions;
 
 private:
-	/** Remaining wait time */
-	float RemainingTime = 0.0f;
+	/** Wait timer callback */
+	void HandleWaitFinished(TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp);
+
+	/** Idle action timer callback: roll IdleActionChance and schedule the next check */
+	void HandleIdleActionCheck(TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp);
 
-	/** Time until next idle action chance */
-	float NextActionCheckTime = 0.0f;
+	/** Schedule the next idle action check Delay seconds from now */
+	void ScheduleIdleActionCheck(UBehaviorTreeComponent& OwnerComp, FBTCatWaitTaskMemory& Memory, float Delay);
 };
@@ -4,10 +4,40 @@
 
 #include "CoreMinimal.h"
 #include "BehaviorTree/BTTaskNode.h"
+#include "AITypes.h"
+#include "AI/Navigation/NavigationTypes.h"
+#include "Engine/TimerHandle.h"
 #include "BTTask_CatWander.generated.h"
 
+struct FPathFollowingResult;
+
+/** Per-cat runtime state of UBTTask_CatWander, stored in the behavior tree's node memory */
+struct FBTCatWanderTaskMemory
+{
+	/** The target location we're moving to */
+	FVector TargetLocation = FVector::ZeroVector;
+
+	/** Whether we successfully found a valid location */
+	bool bHasValidTarget = false;
+
+	/** Pending async path query (INVALID_NAVQUERYID when none) */
+	uint32 PathQueryID = INVALID_NAVQUERYID;
+
+	/** Next-frame retry while the per-frame nav query budget is used up */
+	FTimerHandle RetryTimerHandle;
+
+	/** Path following request started by this task */
+	FAIRequestID MoveRequestID;
+
+	/** Binding on the path following component's OnRequestFinished */
+	FDelegateHandle MoveFinishedHandle;
+};
+
 /**
  * Behavior Tree Task: Make the cat wander to a random nearby location
+ * The destination comes from USmartCatNavPointSubsystem when it has points nearby, otherwise from a navmesh query.
+ * The path is found asynchronously (at most SmartCat.Wander.MaxNavQueriesPerFrame queries start per frame)
+ * and the task finishes when the path following component reports the move request finished; the task does not tick
  */
 UCLASS()
 class SMARTCATAI_API UBTTask_CatWander : public UBTTaskNode
@@ -18,7 +48,11 @@ public:
 	UBTTask_CatWander();
 
 	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
-	virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+	virtual void OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult) override;
+	virtual uint16 GetInstanceMemorySize() const override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+	virtual void CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const override;
+	virtual void DescribeRuntimeValues(const UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTDescriptionVerbosity::Type Verbosity, TArray<FString>& Values) const override;
 	virtual FString GetStaticDescription() const override;
 
 protected:
@@ -34,10 +68,23 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "SmartCatAI", meta = (ClampMin = "0"))
 	float AcceptanceRadius = 50.0f;
 
+	/** Nav point pool tags to wander to (none = any); see USmartCatNavPointSubsystem */
+	UPROPERTY(EditAnywhere, Category = "SmartCatAI", meta = (Bitmask, BitmaskEnum = "/Script/SmartCatAI.ECatNavPointTag"))
+	int32 WanderPointTags = 0;
+
 private:
-	/** The target location we're moving to */
-	FVector TargetLocation;
+	/** Pick a wander point and start the async path query; returns InProgress, or Failed if no query could start */
+	EBTNodeResult::Type StartPathQuery(UBehaviorTreeComponent& OwnerComp, FBTCatWanderTaskMemory& Memory);
 
-	/** Whether we successfully found a valid location */
-	bool bHasValidTarget = false;
+	/** Start the query if the frame's budget allows it, otherwise retry next frame */
+	EBTNodeResult::Type StartPathQueryWithinBudget(UBehaviorTreeComponent& OwnerComp, FBTCatWanderTaskMemory& Memory);
+
+	/** Next-frame retry callback */
+	void HandleRetry(TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp);
+
+	/** UNavigationSystemV1::FindPathAsync callback (game thread) */
+	void HandlePathFound(uint32 QueryID, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path, TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp);
+
+	/** UPathFollowingComponent::OnRequestFinished callback */
+	void HandleMoveFinished(FAIRequestID RequestID, const FPathFollowingResult& Result, TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp);
 };
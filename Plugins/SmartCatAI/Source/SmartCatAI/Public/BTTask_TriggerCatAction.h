@@ -4,12 +4,27 @@
 
 #include "CoreMinimal.h"
 #include "BehaviorTree/BTTaskNode.h"
+#include "Engine/TimerHandle.h"
 #include "SmartCatAnimInstance.h"
 #include "BTTask_TriggerCatAction.generated.h"
 
+/** Per-cat runtime state of UBTTask_TriggerCatAction, stored in the behavior tree's node memory */
+struct FBTTriggerCatActionTaskMemory
+{
+	/** Anim instance whose OnActionFinished we are bound to */
+	TWeakObjectPtr<USmartCatAnimInstance> AnimInstance;
+
+	/** Binding on AnimInstance->OnActionFinished */
+	FDelegateHandle ActionFinishedHandle;
+
+	/** Fires after MaxWaitTime */
+	FTimerHandle TimeoutTimerHandle;
+};
+
 /**
  * Behavior Tree Task: Trigger a cat animation action
  * Plays the specified action animation and waits for it to complete
+ * (USmartCatAnimInstance::OnActionFinished or the MaxWaitTime timer; the task does not tick)
  */
 UCLASS()
 class SMARTCATAI_API UBTTask_TriggerCatAction : public UBTTaskNode
@@ -20,7 +35,10 @@ public:
 	UBTTask_TriggerCatAction();
 
 	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
-	virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+	virtual void OnTaskFinished(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTNodeResult::Type TaskResult) override;
+	virtual uint16 GetInstanceMemorySize() const override;
+	virtual void InitializeMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryInit::Type InitType) const override;
+	virtual void CleanupMemory(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, EBTMemoryClear::Type CleanupType) const override;
 	virtual FString GetStaticDescription() const override;
 
 protected:
@@ -37,6 +55,7 @@ protected:
 	float MaxWaitTime = 5.0f;
 
 private:
-	/** Track how long we've been waiting */
-	float WaitTime = 0.0f;
+	/** Action finished or wait timed out */
+	void HandleActionFinished(ECatAnimationAction Action, TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp);
+	void HandleTimeout(TWeakObjectPtr<UBehaviorTreeComponent> OwnerComp);
 };
@@ -17,6 +17,21 @@ enum class EQuadrupedGait : uint8
 	Gallop  UMETA(DisplayName = "Gallop"),
 };
 
+/**
+ * Leg indices for per-leg arrays (order matches FL, FR, BL, BR everywhere in the plugin)
+ */
+namespace EQuadrupedLeg
+{
+	enum Type : int32
+	{
+		FrontLeft = 0,
+		FrontRight,
+		BackLeft,
+		BackRight,
+		Num
+	};
+}
+
 /**
  * Configuration for quadruped gait calculations
  */
@@ -132,6 +147,14 @@ struct SMARTCATAI_API FQuadrupedGaitState
 	float DebugSpeed = 0.0f;
 };
 
+/**
+ * All four leg outputs for one cat (indexed by EQuadrupedLeg), used by the batch API
+ */
+struct FQuadrupedGaitLegOutputs
+{
+	FQuadrupedLegGaitOutput Legs[EQuadrupedLeg::Num];
+};
+
 /**
  * Static utility class for quadruped gait calculations
  * Can be used by both AnimInstance and Control Rig
@@ -189,22 +212,79 @@ public:
 		const FVector& MoveDirection
 	);
 
-private:
-	/** Get phase offsets for the given gait */
-	static void GetPhaseOffsets(EQuadrupedGait Gait, float& OutFL, float& OutFR, float& OutBL, float& OutBR);
+	/**
+	 * Calculate gait output for all four legs in one pass (indexed by EQuadrupedLeg)
+	 * Gait selection, phase offsets, swing duration and move rotation are resolved once
+	 */
+	static void CalculateAllLegs(
+		const FQuadrupedGaitState& State,
+		const FQuadrupedGaitConfig& Config,
+		const FVector& MoveDirection,
+		FQuadrupedLegGaitOutput (&OutLegs)[EQuadrupedLeg::Num]
+	);
 
-	/** Get swing duration for the given gait */
-	static float GetSwingDuration(EQuadrupedGait Gait);
+	/**
+	 * Update gait state and all leg outputs for many cats in one call
+	 * All views are indexed by cat and must have the same length; each cat advances by its
+	 * own DeltaTimes entry. Work is split into chunks of BatchChunkSize cats and run with ParallelFor
+	 */
+	static void UpdateGaitStateBatch(
+		TArrayView<FQuadrupedGaitState> States,
+		TArrayView<const FQuadrupedGaitConfig> Configs,
+		TArrayView<const FVector> Velocities,
+		TArrayView<const FVector> MoveDirections,
+		TArrayView<const float> DeltaTimes,
+		TArrayView<FQuadrupedGaitLegOutputs> OutLegs
+	);
 
-	/** Calculate step curve (0 when grounded, peaks at 0.5 of swing) */
-	static float CalculateStepCurve(float Phase, float SwingDuration);
+	/** Cats per ParallelFor task in UpdateGaitStateBatch */
+	static constexpr int32 BatchChunkSize = 64;
+
+	/**
+	 * Scalar reference for CalculateAllLegs: evaluates each leg with CalculateLegOutput
+	 * Kept for validating the vectorized kernel; the SmartCatAI.Gait.VectorizedMatchesScalar
+	 * automation test checks that results match within float rounding
+	 */
+	static void CalculateAllLegsScalar(
+		const FQuadrupedGaitState& State,
+		const FQuadrupedGaitConfig& Config,
+		const FVector& MoveDirection,
+		FQuadrupedLegGaitOutput (&OutLegs)[EQuadrupedLeg::Num]
+	);
+
+private:
+	/** Per-call values shared by every leg */
+	struct FLegEvalContext
+	{
+		EQuadrupedGait ActiveGait = EQuadrupedGait::Walk;
+		float SwingDuration = 0.25f;
+		float LiftHeightScale = 15.0f;
+		FVector SafeMoveDir = FVector::ForwardVector;
+		FRotator MoveRotation = FRotator::ZeroRotator;
+	};
+
+	/** Resolve the active gait and movement rotation once for a set of leg evaluations */
+	static FLegEvalContext MakeLegEvalContext(
+		const FQuadrupedGaitState& State,
+		const FQuadrupedGaitConfig& Config,
+		const FVector& MoveDirection
+	);
+
+	/** Animated path of CalculateAllLegs: runs the gait-specialized four-lane kernel from QuadrupedGaitCore */
+	static void CalculateAllLegsVectorized(
+		const FQuadrupedGaitState& State,
+		const FQuadrupedGaitConfig& Config,
+		const FVector& MoveDirection,
+		const FLegEvalContext& Context,
+		FQuadrupedLegGaitOutput (&OutLegs)[EQuadrupedLeg::Num]
+	);
 
 	/** Calculate output for a single leg given its phase offset */
 	static FQuadrupedLegGaitOutput CalculateLegOutput(
 		const FQuadrupedGaitState& State,
 		const FQuadrupedGaitConfig& Config,
 		const FVector& MoveDirection,
-		float PhaseOffset,
-		float SwingDuration
+		const FLegEvalContext& Context,
+		float PhaseOffset
 	);
 };
@@ -0,0 +1,219 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "QuadrupedGaitCalculator.h"
+#include "Math/VectorRegister.h"
+
+/**
+ * Header-only gait core shared by UQuadrupedGaitCalculator (AnimBP path) and
+ * FRigUnit_ClaudeQuadrupedIK (Control Rig path). Gait tables are indexed by
+ * EQuadrupedGait, leg tables by EQuadrupedLeg.
+ */
+namespace QuadrupedGaitCore
+{
+	constexpr int32 NumGaits = 4;
+
+	/** Below this horizontal speed (cm/s) the gait cycle does not advance and no procedural motion is added */
+	constexpr float MinMoveSpeed = 0.1f;
+
+	/** Per-gait parameters; everything that differs between gaits lives here */
+	struct FGaitParams
+	{
+		/** Phase offset of each leg within the gait cycle (when it starts its swing) */
+		float PhaseOffsets[EQuadrupedLeg::Num];
+
+		/** Fraction of the cycle each foot is in the air */
+		float SwingDuration;
+
+		/** Whether step height scales with Speed / GallopSpeed (clamped to 0.5-1.5) */
+		bool bScaleLiftWithSpeed;
+	};
+
+	/** Gait table, indexed by EQuadrupedGait */
+	constexpr FGaitParams GaitTable[NumGaits] =
+	{
+		{ { 0.25f, 0.75f, 0.0f, 0.5f }, 0.2f, false },		// Stroll: same 4-beat lateral sequence as walk, more relaxed timing
+		{ { 0.25f, 0.75f, 0.0f, 0.5f }, 0.25f, false },		// Walk: LH(0) -> LF(0.25) -> RH(0.5) -> RF(0.75)
+		{ { 0.0f, 0.5f, 0.5f, 0.0f }, 0.4f, false },		// Trot: 2-beat diagonal pairs
+		{ { 0.55f, 0.45f, 0.05f, 0.0f }, 0.35f, true },		// Gallop: asymmetric bounding, back legs lead
+	};
+
+	static_assert(static_cast<int32>(EQuadrupedGait::Stroll) == 0 && static_cast<int32>(EQuadrupedGait::Gallop) == NumGaits - 1,
+		"Gait tables are indexed by EQuadrupedGait");
+
+	FORCEINLINE int32 GetGaitIndex(EQuadrupedGait Gait)
+	{
+		return FMath::Min(static_cast<int32>(Gait), NumGaits - 1);
+	}
+
+	FORCEINLINE const float (&GetPhaseOffsets(EQuadrupedGait Gait))[EQuadrupedLeg::Num]
+	{
+		return GaitTable[GetGaitIndex(Gait)].PhaseOffsets;
+	}
+
+	FORCEINLINE float GetSwingDuration(EQuadrupedGait Gait)
+	{
+		return GaitTable[GetGaitIndex(Gait)].SwingDuration;
+	}
+
+	/**
+	 * Gait for a horizontal speed given the Stroll/Walk/Trot upper thresholds.
+	 * Branchless; same result as testing the thresholds in order (even if they are not ascending).
+	 */
+	FORCEINLINE EQuadrupedGait DetectGait(float Speed, float StrollSpeed, float WalkSpeed, float TrotSpeed)
+	{
+		const int32 AboveStroll = Speed >= StrollSpeed;
+		const int32 AboveWalk = AboveStroll & (Speed >= WalkSpeed);
+		const int32 AboveTrot = AboveWalk & (Speed >= TrotSpeed);
+		return static_cast<EQuadrupedGait>(AboveStroll + AboveWalk + AboveTrot);
+	}
+
+	/** Gait cycles per second at Speed (0 when idle or StrideLength is not positive) */
+	FORCEINLINE float GetStepsPerSecond(float Speed, float StrideLength)
+	{
+		return (StrideLength > 0.0f && Speed > MinMoveSpeed) ? Speed / StrideLength : 0.0f;
+	}
+
+	/** Advance the accumulated cycle phase (0-1, wraps); unchanged when idle or procedural gait is off */
+	FORCEINLINE float AdvancePhase(float AccumulatedPhase, float Speed, float StrideLength, float SpeedMultiplier, float DeltaTime, bool bProceduralGait)
+	{
+		if (bProceduralGait && Speed > MinMoveSpeed)
+		{
+			const float EffectiveMultiplier = FMath::Max(SpeedMultiplier, 0.1f);
+			AccumulatedPhase += GetStepsPerSecond(Speed, StrideLength) * DeltaTime * EffectiveMultiplier;
+			AccumulatedPhase = FMath::Fmod(AccumulatedPhase, 1.0f);
+		}
+		return AccumulatedPhase;
+	}
+
+	/** Phase of one leg (0-1) given the cycle phase and the leg's offset */
+	FORCEINLINE float GetLegPhase(float AccumulatedPhase, float PhaseOffset)
+	{
+		return FMath::Fmod(AccumulatedPhase + PhaseOffset, 1.0f);
+	}
+
+	/** Step height curve: 0 when grounded, peaks at 0.5 of the swing phase */
+	FORCEINLINE float CalculateStepCurve(float LegPhase, float SwingDuration)
+	{
+		return LegPhase < SwingDuration ? FMath::Sin(LegPhase / SwingDuration * PI) : 0.0f;
+	}
+
+	/** Forward/backward foot offset: swing moves back to front (-Half -> +Half), stance slides front to back */
+	FORCEINLINE float CalculateStrideOffset(float LegPhase, float SwingDuration, float HalfStride)
+	{
+		if (LegPhase < SwingDuration)
+		{
+			return FMath::Lerp(-HalfStride, HalfStride, LegPhase / SwingDuration);
+		}
+		const float StanceProgress = (LegPhase - SwingDuration) / (1.0f - SwingDuration);
+		return FMath::Lerp(HalfStride, -HalfStride, StanceProgress);
+	}
+
+	/** Lift multiplier for Gait at Speed (gallop steps get higher with speed) */
+	FORCEINLINE float GetLiftSpeedFactor(EQuadrupedGait Gait, float Speed, float GallopSpeed)
+	{
+		const float SpeedFactor = FMath::Clamp(Speed / GallopSpeed, 0.5f, 1.5f);
+		return GaitTable[GetGaitIndex(Gait)].bScaleLiftWithSpeed ? SpeedFactor : 1.0f;
+	}
+
+	// ============================================
+	// Per-gait leg kernels
+	// ============================================
+
+	/** Results of a leg kernel, one entry per EQuadrupedLeg */
+	struct FLegKernelOutput
+	{
+		float Phase[EQuadrupedLeg::Num];
+
+		/** Swing progress (0-1) during swing, 0 during stance */
+		float SwingProgress[EQuadrupedLeg::Num];
+
+		float StrideOffset[EQuadrupedLeg::Num];
+		float LiftHeight[EQuadrupedLeg::Num];
+
+		/** Toe pitch in degrees (up while lifting, down while reaching for the ground) */
+		float ToePitch[EQuadrupedLeg::Num];
+
+		/** Bit per leg set while it is swinging */
+		int32 SwingBits = 0;
+	};
+
+	/**
+	 * Animated leg math for all four legs of a moving cat, one VectorRegister lane per leg.
+	 * Gait is a template parameter so its table entry folds into constants and nothing
+	 * in the kernel branches on gait type; pick the instantiation once with GetLegKernel.
+	 */
+	template <EQuadrupedGait Gait>
+	void EvaluateLegs(float AccumulatedPhase, float Speed, float StrideLength, float StepHeight, float GallopSpeed, FLegKernelOutput& Out)
+	{
+		constexpr FGaitParams Params = GaitTable[static_cast<int32>(Gait)];
+		constexpr float SwingDuration = Params.SwingDuration;
+
+		float LiftScale = StepHeight;
+		if constexpr (Params.bScaleLiftWithSpeed)
+		{
+			LiftScale *= FMath::Clamp(Speed / GallopSpeed, 0.5f, 1.5f);
+		}
+		const float HalfStride = StrideLength * 0.5f;
+
+		const VectorRegister4Float Zero = VectorZeroFloat();
+		const VectorRegister4Float One = VectorOneFloat();
+		const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+		const VectorRegister4Float Swing = VectorSetFloat1(SwingDuration);
+		const VectorRegister4Float InvSwing = VectorSetFloat1(1.0f / SwingDuration);
+		const VectorRegister4Float InvStance = VectorSetFloat1(1.0f / (1.0f - SwingDuration));
+		const VectorRegister4Float HalfStrideV = VectorSetFloat1(HalfStride);
+		const VectorRegister4Float FullStrideV = VectorSetFloat1(HalfStride * 2.0f);
+		const VectorRegister4Float Offsets = MakeVectorRegisterFloat(
+			Params.PhaseOffsets[0], Params.PhaseOffsets[1], Params.PhaseOffsets[2], Params.PhaseOffsets[3]);
+
+		// Leg phase: fmod(AccumulatedPhase + Offset, 1)
+		const VectorRegister4Float Phase = VectorMod(VectorAdd(VectorSetFloat1(AccumulatedPhase), Offsets), One);
+
+		const VectorRegister4Float SwingMask = VectorCompareLT(Phase, Swing);
+
+		// Swing progress (swing lanes) and stance progress (stance lanes)
+		const VectorRegister4Float SwingProgress = VectorMultiply(Phase, InvSwing);
+		const VectorRegister4Float StanceProgress = VectorMultiply(VectorSubtract(Phase, Swing), InvStance);
+
+		// Stride: swing lerps -Half -> +Half, stance lerps +Half -> -Half
+		const VectorRegister4Float SwingStride = VectorMultiplyAdd(FullStrideV, SwingProgress, VectorNegate(HalfStrideV));
+		const VectorRegister4Float StanceStride = VectorSubtract(HalfStrideV, VectorMultiply(FullStrideV, StanceProgress));
+		const VectorRegister4Float StrideOffset = VectorSelect(SwingMask, SwingStride, StanceStride);
+
+		// Lift: sin(progress * PI) * height during swing, zero during stance
+		const VectorRegister4Float Lift = VectorMultiply(
+			VectorSin(VectorMultiply(SwingProgress, VectorSetFloat1(PI))), VectorSetFloat1(LiftScale));
+
+		// Toe pitch: 0 -> -20 over the first half of swing, -20 -> 15 over the second half
+		const VectorRegister4Float PitchRising = VectorMultiply(SwingProgress, VectorSetFloat1(-40.0f));
+		const VectorRegister4Float PitchLowering = VectorMultiplyAdd(
+			VectorSubtract(SwingProgress, Half), VectorSetFloat1(70.0f), VectorSetFloat1(-20.0f));
+		const VectorRegister4Float SwingPitch = VectorSelect(VectorCompareLT(SwingProgress, Half), PitchRising, PitchLowering);
+
+		VectorStore(Phase, Out.Phase);
+		VectorStore(VectorSelect(SwingMask, SwingProgress, Zero), Out.SwingProgress);
+		VectorStore(StrideOffset, Out.StrideOffset);
+		VectorStore(VectorSelect(SwingMask, Lift, Zero), Out.LiftHeight);
+		VectorStore(VectorSelect(SwingMask, SwingPitch, Zero), Out.ToePitch);
+		Out.SwingBits = VectorMaskBits(SwingMask);
+	}
+
+	using FLegKernel = void (*)(float AccumulatedPhase, float Speed, float StrideLength, float StepHeight, float GallopSpeed, FLegKernelOutput& Out);
+
+	/** EvaluateLegs instantiations, indexed by EQuadrupedGait */
+	constexpr FLegKernel LegKernels[NumGaits] =
+	{
+		&EvaluateLegs<EQuadrupedGait::Stroll>,
+		&EvaluateLegs<EQuadrupedGait::Walk>,
+		&EvaluateLegs<EQuadrupedGait::Trot>,
+		&EvaluateLegs<EQuadrupedGait::Gallop>,
+	};
+
+	FORCEINLINE FLegKernel GetLegKernel(EQuadrupedGait Gait)
+	{
+		return LegKernels[GetGaitIndex(Gait)];
+	}
+}
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Units/RigUnit.h"
+#include "Engine/EngineTypes.h"
 #include "RigUnit_ClaudeQuadrupedIK.generated.h"
 
 /**
@@ -76,12 +77,35 @@ struct SMARTCATAI_API FClaudeQuadrupedLegOutput
 	bool bIsSwinging = false;
 };
 
+/**
+ * Per-execute values shared by every leg solve of FRigUnit_ClaudeQuadrupedIK
+ * (plain struct so a leg can be solved outside a rig, e.g. by the microbenchmarks)
+ */
+struct FClaudeQuadrupedLegSolveContext
+{
+	float AccumulatedPhase = 0.0f;
+	float SwingDuration = 0.25f;
+	float Speed = 0.0f;
+	FVector MoveDirection = FVector::ZeroVector;
+	bool bProceduralGait = true;
+	float StrideLength = 40.0f;
+	/** StepHeight times the active gait's lift speed factor, resolved once per execute */
+	float LiftHeightScale = 15.0f;
+	float FootHeight = 2.0f;
+	float MaxIKOffset = 30.0f;
+	bool bAlignFootToGround = true;
+	float MaxFootAngle = 45.0f;
+};
+
 /**
  * ClaudeQuadrupedIK - A Control Rig unit for procedural quadruped locomotion
  *
  * This node generates procedural walking/trotting/galloping animation for
  * quadruped characters with automatic foot placement and terrain adaptation.
  *
+ * Foot ground queries use world collision when the rig runs in a world, so Control-Rig-driven
+ * cats get terrain adaptation without the AnimBP path.
+ *
  * Supports three gaits:
  * - Walk: 4-beat lateral sequence gait
  * - Trot: 2-beat diagonal gait
@@ -117,6 +141,23 @@ struct SMARTCATAI_API FRigUnit_ClaudeQuadrupedIK : public FRigUnitMutable
 	RIGVM_METHOD()
 	virtual void Execute() override;
 
+	/** Intersect the trace TraceStart -> TraceEnd with the ground plane Z = GroundZ */
+	static bool TraceGroundPlane(const FVector& TraceStart, const FVector& TraceEnd, float GroundZ, FVector& OutHitPoint);
+
+	/**
+	 * Solve one leg from its foot transform and ground hit (pure function of its inputs)
+	 * @return Foot offset used for the pelvis adjustment, clamped to MaxIKOffset
+	 */
+	static float SolveLeg(
+		const FClaudeQuadrupedLegSolveContext& Context,
+		const FTransform& FootTransform,
+		float PhaseOffset,
+		bool bHit,
+		const FVector& HitPoint,
+		const FVector& HitNormal,
+		FClaudeQuadrupedLegOutput& Output
+	);
+
 	// ============================================
 	// Inputs - Character State
 	// ============================================
@@ -185,6 +226,14 @@ struct SMARTCATAI_API FRigUnit_ClaudeQuadrupedIK : public FRigUnitMutable
 	UPROPERTY(EditAnywhere, meta = (Input))
 	float FootHeight;
 
+	/** Trace feet against world collision; without a world (or when off) the ground is a flat plane at ComponentTransform Z */
+	UPROPERTY(EditAnywhere, meta = (Input))
+	bool bTraceWorld = true;
+
+	/** Collision channel for the foot traces */
+	UPROPERTY(EditAnywhere, meta = (Input))
+	TEnumAsByte<ECollisionChannel> TraceChannel = ECC_Visibility;
+
 	// ============================================
 	// Inputs - Gait Control
 	// ============================================
@@ -304,4 +353,26 @@ struct SMARTCATAI_API FRigUnit_ClaudeQuadrupedIK : public FRigUnitMutable
 	/** Internal accumulated phase for gait cycle (persists between frames) */
 	UPROPERTY(Transient, meta = (Input, Output))
 	float AccumulatedPhase = 0.0f;
+
+	// ============================================
+	// Cached hierarchy indices (resolved from the bone keys, refreshed when the hierarchy changes)
+	// ============================================
+
+	UPROPERTY(Transient)
+	FCachedRigElement CachedFrontLeftFoot;
+
+	UPROPERTY(Transient)
+	FCachedRigElement CachedFrontRightFoot;
+
+	UPROPERTY(Transient)
+	FCachedRigElement CachedBackLeftFoot;
+
+	UPROPERTY(Transient)
+	FCachedRigElement CachedBackRightFoot;
+
+	UPROPERTY(Transient)
+	FCachedRigElement CachedClavicle;
+
+	UPROPERTY(Transient)
+	FCachedRigElement CachedThigh;
 };
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "AIController.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
 #include "SmartCatAnimInstance.h"
 #include "SmartCatAIController.generated.h"
 
@@ -60,6 +61,11 @@ protected:
 	virtual void OnUnPossess() override;
 
 public:
+	virtual void Tick(float DeltaSeconds) override;
+
+	/** Runs the tree and resolves the blackboard key IDs this controller writes */
+	virtual bool RunBehaviorTree(UBehaviorTree* BTAsset) override;
+
 	// ============================================
 	// High-Level Commands
 	// ============================================
@@ -104,6 +110,10 @@ public:
 	UFUNCTION(BlueprintPure, Category = "SmartCatAI|State")
 	bool IsPlayingAction() const;
 
+	/** Anim instance of the controlled cat (null if not possessing a cat with USmartCatAnimInstance) */
+	UFUNCTION(BlueprintPure, Category = "SmartCatAI|State")
+	USmartCatAnimInstance* GetCatAnimInstance() const;
+
 	// ============================================
 	// Perception Events
 	// ============================================
@@ -166,6 +176,38 @@ private:
 	UPROPERTY()
 	TObjectPtr<ASmartCatAICharacter> CatCharacter;
 
-	/** Update blackboard with current state */
-	void UpdateBlackboard();
+	// ============================================
+	// Blackboard Writes
+	// ============================================
+
+	/** Key IDs of the BB_ names in the running blackboard (FBlackboard::InvalidKey if the asset lacks the key) */
+	struct FBlackboardKeyIDs
+	{
+		FBlackboard::FKey MoveTarget = FBlackboard::InvalidKey;
+		FBlackboard::FKey LookTarget = FBlackboard::InvalidKey;
+		FBlackboard::FKey CurrentMood = FBlackboard::InvalidKey;
+		FBlackboard::FKey CurrentBehavior = FBlackboard::InvalidKey;
+		FBlackboard::FKey InterestLevel = FBlackboard::InvalidKey;
+		FBlackboard::FKey CurrentAction = FBlackboard::InvalidKey;
+	};
+	FBlackboardKeyIDs BlackboardKeys;
+
+	/** State values that changed since the last flush (EDirtyBlackboardValue bits) */
+	enum EDirtyBlackboardValue : uint8
+	{
+		DirtyMood = 1 << 0,
+		DirtyBehavior = 1 << 1,
+		DirtyInterest = 1 << 2,
+		DirtyAll = DirtyMood | DirtyBehavior | DirtyInterest,
+	};
+	uint8 DirtyBlackboardValues = 0;
+
+	/** Clamp to 0-1 and queue the blackboard write if it changed */
+	void SetInterestLevel(float NewInterestLevel);
+
+	/** Queue state values for the next flush (at most once per frame, from Tick) */
+	void MarkBlackboardDirty(uint8 DirtyValues) { DirtyBlackboardValues |= DirtyValues; }
+
+	/** Write the dirty state values to the blackboard */
+	void FlushBlackboard();
 };
@@ -4,10 +4,14 @@
 
 #include "CoreMinimal.h"
 #include "Animation/AnimInstance.h"
+#include "WorldCollision.h"
 #include "QuadrupedGaitCalculator.h"
+#include "SmartCatIKRecorder.h"
+#include "SmartCatIKFlightRecorder.h"
 #include "SmartCatAnimInstance.generated.h"
 
 class ASmartCatAICharacter;
+class USmartCatGaitSubsystem;
 
 /**
  * Animation action types that can be triggered
@@ -31,6 +35,9 @@ enum class ECatAnimationAction : uint8
 	Stretch  UMETA(DisplayName = "Stretch"),
 };
 
+/** Broadcast by USmartCatAnimInstance when the playing action is cleared */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnCatActionFinished, ECatAnimationAction /* Action */);
+
 /**
  * IK mode for the cat animation system
  */
@@ -50,6 +57,22 @@ enum class ECatIKMode : uint8
 	FullProcedural UMETA(DisplayName = "Full Procedural"),
 };
 
+/**
+ * IK level of detail, picked from distance to the nearest local viewer and on-screen size
+ */
+UENUM(BlueprintType)
+enum class ECatIKLOD : uint8
+{
+	/** Per-foot traces and the configured IK mode */
+	Full UMETA(DisplayName = "Full"),
+
+	/** One trace under the body; slope adaptation only */
+	SlopeOnly UMETA(DisplayName = "Slope Only"),
+
+	/** IK disabled */
+	Off UMETA(DisplayName = "Off"),
+};
+
 UCLASS()
 class SMARTCATAI_API USmartCatAnimInstance : public UAnimInstance
 {
@@ -60,6 +83,8 @@ public:
 
 	virtual void NativeInitializeAnimation() override;
 	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
+	virtual void NativeUninitializeAnimation() override;
 
 	UFUNCTION(BlueprintCallable, Category = "SmartCatAI|Animation")
 	ASmartCatAICharacter* GetSmartCatCharacter() const { return CatCharacter; }
@@ -114,6 +139,16 @@ public:
 	UFUNCTION(BlueprintPure, Category = "SmartCatAI|Animation")
 	ECatAnimationAction GetCurrentAction() const { return CurrentAction; }
 
+	/** Fires from ClearAction when an action was playing (game thread) */
+	FOnCatActionFinished OnActionFinished;
+
+	/** Enable or disable IK LOD; when disabled every cat runs full IK regardless of viewers or rendering */
+	UFUNCTION(BlueprintCallable, Category = "SmartCatAI|IK")
+	void SetIKLODEnabled(bool bEnabled);
+
+	UFUNCTION(BlueprintPure, Category = "SmartCatAI|IK")
+	bool IsIKLODEnabled() const { return bEnableIKLOD; }
+
 	/**
 	 * Debug: Export gait data to CSV file for analysis
 	 * Outputs phase, swing status, lift height for each leg across speed range
@@ -126,6 +161,35 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "SmartCatAI|Debug")
 	void ExportGaitDataToCSV(float MinSpeed = 0.0f, float MaxSpeed = 500.0f, float SpeedStep = 25.0f, float TimeStep = 0.016f, float CycleDuration = 2.0f);
 
+	/**
+	 * Debug: Export the same gait sweep as ExportGaitDataToCSV to a compact binary trace
+	 * (Saved/GaitData.sctrace); convert offline with -run=SmartCatTrace
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SmartCatAI|Debug")
+	void ExportGaitDataToTrace(float MinSpeed = 0.0f, float MaxSpeed = 500.0f, float SpeedStep = 25.0f, float TimeStep = 0.016f, float CycleDuration = 2.0f);
+
+	/**
+	 * Gait sweep behind ExportGaitDataToCSV for an arbitrary config (no world or mesh needed).
+	 * Speeds are simulated in parallel into per-speed buffers and joined in order.
+	 * @return CSV text including the header, or empty if the step sizes are invalid
+	 */
+	static FString BuildGaitSweepCSV(const FQuadrupedGaitConfig& Config, float MinSpeed, float MaxSpeed, float SpeedStep, float TimeStep, float CycleDuration);
+
+	/** Gait sweep behind ExportGaitDataToTrace for an arbitrary config, written to FilePath */
+	static bool WriteGaitSweepTrace(const FQuadrupedGaitConfig& Config, float MinSpeed, float MaxSpeed, float SpeedStep, float TimeStep, float CycleDuration, const FString& FilePath);
+
+	/**
+	 * Slope Adaptation: body pitch/roll (degrees, clamped, unsmoothed) from the ground height under each paw
+	 * @param GroundZ - Ground height per EQuadrupedLeg
+	 * @param OutAverageGroundZ - Mean of the four ground heights
+	 */
+	static void ComputeSlopeAngles(const float (&GroundZ)[EQuadrupedLeg::Num], float InBodyLength, float InBodyWidth,
+		float MaxPitch, float MaxRoll, float& OutAverageGroundZ, float& OutPitch, float& OutRoll);
+
+	/** Slope Adaptation: per-paw height left over once the body is rotated by Pitch/Roll, clamped to InMaxIKOffset */
+	static void ComputeSlopeResiduals(const float (&GroundZ)[EQuadrupedLeg::Num], float InAverageGroundZ, float Pitch, float Roll,
+		float InBodyLength, float InBodyWidth, float InFootHeight, float InMaxIKOffset, float (&OutResiduals)[EQuadrupedLeg::Num]);
+
 	/** Debug: Start recording real-time IK data during gameplay */
 	UFUNCTION(BlueprintCallable, Category = "SmartCatAI|Debug")
 	void StartRuntimeDebugRecording();
@@ -138,6 +202,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "SmartCatAI|Debug")
 	void PrintDebugState();
 
+	/**
+	 * Debug: write the IK flight recorder (last FlightRecorderSeconds of IK state) to
+	 * Saved/SmartCatIK/ as CSV. Also available as the SmartCat.IK.DumpFlightRecorder console command.
+	 * @return Path of the file being written, or empty if the recorder is off
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SmartCatAI|Debug")
+	FString DumpIKFlightRecorder(const FString& Reason);
+
 protected:
 	/** Whether we're recording debug data */
 	bool bIsRecordingDebug = false;
@@ -145,6 +217,40 @@ protected:
 	/** Accumulated debug data */
 	FString DebugRecordingData;
 
+	/** Background writer for runtime debug rows (created on first StartRuntimeDebugRecording) */
+	TUniquePtr<FSmartCatIKRecorder> DebugRecorder;
+
+	/** Seconds since StartRuntimeDebugRecording */
+	float DebugRecordingTime = 0.0f;
+
+	// ============================================
+	// IK Flight Recorder
+	// ============================================
+
+	/** Keep the last FlightRecorderSeconds of IK state in memory so glitches can be dumped after the fact */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmartCatAI|Debug|FlightRecorder")
+	bool bEnableIKFlightRecorder = true;
+
+	/** Seconds of history kept (buffer is sized for this at FlightRecorderFrameRate) */
+	UPROPERTY(EditAnywhere, Category = "SmartCatAI|Debug|FlightRecorder", meta = (ClampMin = "0.5", EditCondition = "bEnableIKFlightRecorder"))
+	float FlightRecorderSeconds = 5.0f;
+
+	/** Frame rate the buffer is sized for */
+	UPROPERTY(EditAnywhere, Category = "SmartCatAI|Debug|FlightRecorder", meta = (ClampMin = "1", EditCondition = "bEnableIKFlightRecorder"))
+	int32 FlightRecorderFrameRate = 60;
+
+	/** Dump automatically when a NaN target, a pinned foot offset or an offset pop is detected (not in Shipping builds) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmartCatAI|Debug|FlightRecorder", meta = (EditCondition = "bEnableIKFlightRecorder"))
+	bool bDumpFlightRecorderOnAnomaly = true;
+
+	/** Frame-to-frame foot offset change (cm) on a planted foot that counts as a pop */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmartCatAI|Debug|FlightRecorder", meta = (ClampMin = "0.0", EditCondition = "bEnableIKFlightRecorder"))
+	float FlightRecorderPopThreshold = 10.0f;
+
+	/** Minimum seconds between automatic dumps of this cat */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmartCatAI|Debug|FlightRecorder", meta = (ClampMin = "0.0", EditCondition = "bEnableIKFlightRecorder"))
+	float FlightRecorderDumpCooldown = 10.0f;
+
 protected:
 	// ============================================
 	// IK Mode
@@ -154,6 +260,10 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmartCatAI|IK")
 	ECatIKMode IKMode = ECatIKMode::SlopeAdaptation;
 
+	/** Current IK level of detail (read-only, updated automatically) */
+	UPROPERTY(BlueprintReadOnly, Category = "SmartCatAI|IK")
+	ECatIKLOD CurrentIKLOD = ECatIKLOD::Full;
+
 	// ============================================
 	// Terrain Adaptation IK Data (for Animation Blueprint)
 	// These are OFFSETS from the animated bone position
@@ -373,6 +483,25 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmartCatAI|IK|Config")
 	TEnumAsByte<ECollisionChannel> TraceChannel = ECC_Visibility;
 
+	/**
+	 * Submit all four paw traces as one async batch and read the results on the next frame.
+	 * When off (or before the first batch completes) the blocking per-foot trace is used instead.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmartCatAI|IK|Config")
+	bool bUseAsyncFootTraces = true;
+
+	/** Reuse the last ground hit under a paw while the paw stays put, instead of tracing again */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmartCatAI|IK|Config")
+	bool bUseGroundSampleCache = true;
+
+	/** Paw movement (cm) since the cached sample that forces a new trace */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmartCatAI|IK|Config", meta = (ClampMin = "0.0", EditCondition = "bUseGroundSampleCache"))
+	float GroundCacheMoveThreshold = 2.0f;
+
+	/** Maximum age (seconds) of a cached ground sample before it is traced again */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmartCatAI|IK|Config", meta = (ClampMin = "0.0", EditCondition = "bUseGroundSampleCache"))
+	float GroundCacheMaxAge = 0.5f;
+
 	/** Maximum IK adjustment distance (prevents extreme stretching) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmartCatAI|IK|Config")
 	float MaxIKOffset = 30.0f;
@@ -433,6 +562,45 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmartCatAI|IK|Debug")
 	bool bDrawDebugTraces = false;
 
+	// ============================================
+	// IK LOD
+	// ============================================
+
+	/** Reduce IK work for cats far from every local viewer or small on screen */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmartCatAI|IK|LOD")
+	bool bEnableIKLOD = true;
+
+	/** Within this distance (cm) of a viewer, run full per-foot IK */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmartCatAI|IK|LOD", meta = (ClampMin = "0.0", EditCondition = "bEnableIKLOD"))
+	float IKLODFullDistance = 1500.0f;
+
+	/** Within this distance (cm) of a viewer, run slope-only IK; beyond it IK is off */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmartCatAI|IK|LOD", meta = (ClampMin = "0.0", EditCondition = "bEnableIKLOD"))
+	float IKLODSlopeDistance = 4000.0f;
+
+	/** Distance band (cm) around each threshold that must be crossed before the LOD changes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmartCatAI|IK|LOD", meta = (ClampMin = "0.0", EditCondition = "bEnableIKLOD"))
+	float IKLODHysteresis = 250.0f;
+
+	/** Mesh LOD at or above which full IK drops to slope-only (screen-size proxy) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmartCatAI|IK|LOD", meta = (ClampMin = "0", EditCondition = "bEnableIKLOD"))
+	int32 IKLODSlopeOnlyMeshLOD = 2;
+
+	/** Turn IK off for cats not rendered within this many seconds */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmartCatAI|IK|LOD", meta = (ClampMin = "0.0", EditCondition = "bEnableIKLOD"))
+	float IKLODOffscreenTime = 0.25f;
+
+	/**
+	 * Trace ground every N frames at full IK LOD (1 = every frame). Cats are staggered across frames;
+	 * in between, the last hits are slid along their ground plane under the current paws.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmartCatAI|IK|LOD", meta = (ClampMin = "1"))
+	int32 IKUpdateInterval = 1;
+
+	/** Trace ground every N frames at slope-only IK LOD */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmartCatAI|IK|LOD", meta = (ClampMin = "1", EditCondition = "bEnableIKLOD"))
+	int32 IKSlopeOnlyUpdateInterval = 4;
+
 	// ============================================
 	// Gait Configuration
 	// ============================================
@@ -449,9 +617,30 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Category = "SmartCatAI|Gait")
 	EQuadrupedGait CurrentGait;
 
+	/**
+	 * Evaluate gait in the world's batched gait subsystem instead of per instance. Only used in
+	 * Full Procedural IK; results lag one frame, so this pays off for large crowds only.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SmartCatAI|Gait")
+	bool bUseGaitSubsystem = false;
+
 protected:
+	/** Game thread: read velocity and falling state from the character */
 	void UpdateMovementState(float DeltaSeconds);
+
+	/** Game thread: resolve IK mode, sample paw locations and ground traces for the worker update */
+	void GatherIKInputs();
+
+	/** Game thread: pick CurrentIKLOD from viewer distance and screen presence */
+	void UpdateIKLOD();
+
+	/** Worker thread: IK math using data from GatherIKInputs */
 	void UpdateIKTargets(float DeltaSeconds);
+
+	/** Game thread: pull the last batch's gait results and, in Full Procedural IK, queue this frame's inputs */
+	void SyncGaitSlot(float DeltaSeconds);
+
+	/** Worker thread: advance the gait cycle */
 	void UpdateGait(float DeltaSeconds);
 
 	/** Update slope adaptation IK (Mode: SlopeAdaptation) - rotates mesh to match terrain */
@@ -464,8 +653,32 @@ protected:
 	void UpdateProceduralIK(float DeltaSeconds);
 
 private:
-	/** Perform a single foot trace and return the hit location */
-	bool TraceFootToGround(const FName& BoneName, FVector& OutHitLocation, FVector& OutHitNormal);
+	/** Get the ground hit under a paw (async result from last frame if available, otherwise a blocking trace) */
+	bool TraceFootToGround(int32 Leg, const FVector& PawLocation, FVector& OutHitLocation, FVector& OutHitNormal);
+
+	/** Perform a single blocking foot trace below BoneLocation and return the hit location */
+	bool TraceFootToGroundSync(const FVector& BoneLocation, FVector& OutHitLocation, FVector& OutHitNormal);
+
+	/** Queue one async trace per paw for this frame */
+	void SubmitAsyncFootTraces();
+
+	/** Read back the async paw traces queued on the previous frame */
+	void CollectAsyncFootTraces();
+
+	/** Drop any pending or completed async paw traces */
+	void ResetAsyncFootTraces();
+
+	/** Bone name used for the given leg (EQuadrupedLeg index) */
+	const FName& GetLegBoneName(int32 Leg) const;
+
+	/** Resolve the BoneName_* config to bone indices for the current mesh asset */
+	void ResolveBoneIndices();
+
+	/** Copy the per-leg arrays into the Blueprint-visible per-leg properties */
+	void PublishLegMirrors();
+
+	/** Copy the editable IKAlpha_* properties into the per-leg arrays before a solve */
+	void SeedLegAlphas();
 
 	/** Calculate the foot offset needed based on trace result */
 	float CalculateFootOffset(const FVector& TraceHitLocation, const FVector& BoneWorldLocation);
@@ -488,27 +701,161 @@ private:
 	/** Get the effective IK mode (may override based on state) */
 	ECatIKMode GetEffectiveIKMode() const;
 
+	/** Distance (cm) from the cat to the nearest local player view or pawn, or MAX_flt if there is none */
+	float GetNearestViewerDistance() const;
+
+	/** Fill every paw's ground sample from one trace under the pelvis (ECatIKLOD::SlopeOnly) */
+	void TraceBodyToGround();
+
+	/** Whether ground traces run on the given frame for the current IK LOD (staggered by IKStaggerIndex) */
+	bool IsIKSolveFrame(uint64 FrameNumber) const;
+
+	/** Between solves: carry the last solved ground samples over to the current paw locations */
+	void ExtrapolateFootTraces();
+
+	/** Remember this frame's ground samples for ExtrapolateFootTraces */
+	void StoreSolvedFootTraces();
+
+	/** Worker thread: push this frame's IK state into the flight recorder and run the anomaly checks */
+	void RecordIKFlightFrame(float DeltaSeconds);
+
+	/** Simulate a fresh gait state at Speed for CycleDuration and visit every time step */
+	static void SweepGaitAtSpeed(const FQuadrupedGaitConfig& Config, float Speed, float TimeStep, float CycleDuration,
+		TFunctionRef<void(float Speed, float Time, const FQuadrupedGaitState& State, const FQuadrupedLegGaitOutput (&Legs)[EQuadrupedLeg::Num])> Visit);
+
 	// ============================================
 	// Internal trace data
 	// ============================================
 
-	/** Raw trace hit locations before interpolation */
-	FVector RawFootLocation_FrontLeft;
-	FVector RawFootLocation_FrontRight;
-	FVector RawFootLocation_BackLeft;
-	FVector RawFootLocation_BackRight;
+	/**
+	 * Per-leg IK working data, one array entry per EQuadrupedLeg.
+	 * The mode updates loop over these; PublishLegMirrors copies them into the
+	 * Blueprint-visible _FL/_FR/_BL/_BR properties once per update. IKAlpha is
+	 * editable, so SeedLegAlphas copies it back in before each update.
+	 */
+	struct FCatLegIKArrays
+	{
+		float FootOffset[EQuadrupedLeg::Num] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		float RawFootOffset[EQuadrupedLeg::Num] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		float GroundZ[EQuadrupedLeg::Num] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		float ResidualOffset[EQuadrupedLeg::Num] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		float IKAlpha[EQuadrupedLeg::Num] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+		/** Legacy foot offsets (for procedural mode) */
+		float ProceduralFootOffset[EQuadrupedLeg::Num] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+		FVector GroundNormal[EQuadrupedLeg::Num] = { FVector::UpVector, FVector::UpVector, FVector::UpVector, FVector::UpVector };
+		FRotator FootRotation[EQuadrupedLeg::Num] = { FRotator::ZeroRotator, FRotator::ZeroRotator, FRotator::ZeroRotator, FRotator::ZeroRotator };
+		FVector IKFootTarget[EQuadrupedLeg::Num] = { FVector::ZeroVector, FVector::ZeroVector, FVector::ZeroVector, FVector::ZeroVector };
+		FTransform IKFootTransform[EQuadrupedLeg::Num];
+
+		/** Raw trace hit locations before interpolation (procedural mode) */
+		FVector RawFootLocation[EQuadrupedLeg::Num] = { FVector::ZeroVector, FVector::ZeroVector, FVector::ZeroVector, FVector::ZeroVector };
+	};
+
+	FCatLegIKArrays LegIK;
+
+	/** Sign of each leg along the body axis: +1 front, -1 back */
+	static constexpr float LegFrontSign[EQuadrupedLeg::Num] = { 1.0f, 1.0f, -1.0f, -1.0f };
+
+	/** Sign of each leg across the body axis: +1 left, -1 right */
+	static constexpr float LegLeftSign[EQuadrupedLeg::Num] = { 1.0f, -1.0f, 1.0f, -1.0f };
+
+	/** Ground hit under a paw, as returned by an async trace */
+	struct FCatFootTraceResult
+	{
+		FVector HitLocation = FVector::ZeroVector;
+		FVector HitNormal = FVector::UpVector;
+		bool bHit = false;
+		bool bValid = false;
+	};
+
+	/** Handles of the async paw traces queued last frame (indexed by EQuadrupedLeg) */
+	FTraceHandle AsyncFootTraceHandles[EQuadrupedLeg::Num];
+
+	/** Paw bone locations the pending async traces were started from */
+	FVector AsyncFootTraceOrigins[EQuadrupedLeg::Num];
+
+	/** Latest completed async paw traces (indexed by EQuadrupedLeg) */
+	FCatFootTraceResult AsyncFootTraceResults[EQuadrupedLeg::Num];
+
+	/** Last traced ground hit per paw, reused while the paw stays within GroundCacheMoveThreshold */
+	struct FCatGroundSample
+	{
+		FVector PawLocation = FVector::ZeroVector;
+		FCatFootTraceResult Result;
+		double Time = 0.0;
+	};
+
+	FCatGroundSample GroundSamples[EQuadrupedLeg::Num];
+
+	/** Movement base the ground samples were taken on */
+	TWeakObjectPtr<const UPrimitiveComponent> GroundSampleBase;
+
+	/** Current world time, refreshed in GatherIKInputs for the cache lookups */
+	double GroundSampleNow = 0.0;
+
+	/** Cached ground hit for a paw if it is still usable at PawLocation (see GroundCacheMoveThreshold) */
+	bool LookupGroundSample(int32 Leg, const FVector& PawLocation, float MaxDistance, FCatFootTraceResult& OutResult) const;
+
+	/** Remember the ground hit traced for a paw at PawLocation */
+	void StoreGroundSample(int32 Leg, const FVector& PawLocation, const FCatFootTraceResult& Result);
+
+	/** Drop all cached ground samples (e.g. when the character's movement base changes) */
+	void InvalidateGroundSamples();
+
+	/** Bone indices resolved from the BoneName_* config (INDEX_NONE if the name is not a bone) */
+	struct FCatBoneIndexCache
+	{
+		int32 Paws[EQuadrupedLeg::Num] = { INDEX_NONE, INDEX_NONE, INDEX_NONE, INDEX_NONE };
+		int32 Pelvis = INDEX_NONE;
+		int32 Bell = INDEX_NONE;
+		int32 Jaw = INDEX_NONE;
+
+		/** Mesh asset the indices were resolved against */
+		TWeakObjectPtr<const USkeletalMesh> ResolvedMesh;
+	};
+
+	/** World-space bone transforms fetched once per frame */
+	struct FCatBoneSnapshot
+	{
+		FTransform Paws[EQuadrupedLeg::Num];
+		FTransform Pelvis;
+		FTransform Bell;
+		FTransform Jaw;
+		bool bValid = false;
+	};
+
+	/** Fill a snapshot from the cached bone indices (re-resolves them if the mesh asset changed) */
+	void CaptureBoneSnapshot(FCatBoneSnapshot& OutSnapshot);
+
+	FCatBoneIndexCache BoneIndices;
 
-	/** Raw foot Z offsets (before interpolation) */
-	float RawFootOffset_FL = 0.0f;
-	float RawFootOffset_FR = 0.0f;
-	float RawFootOffset_BL = 0.0f;
-	float RawFootOffset_BR = 0.0f;
+	/**
+	 * Per-frame inputs gathered on the game thread in NativeUpdateAnimation.
+	 * NativeThreadSafeUpdateAnimation reads only this, never the mesh, character or world.
+	 */
+	struct FCatAnimGameThreadData
+	{
+		/** IK mode after action overrides */
+		ECatIKMode EffectiveIKMode = ECatIKMode::Disabled;
 
-	/** Legacy foot offsets (for procedural mode) */
-	float FootOffset_FrontLeft = 0.0f;
-	float FootOffset_FrontRight = 0.0f;
-	float FootOffset_BackLeft = 0.0f;
-	float FootOffset_BackRight = 0.0f;
+		/** Whether IK should run this frame */
+		bool bIKEnabled = false;
+
+		/** Paw, pelvis, bell and jaw transforms for this frame */
+		FCatBoneSnapshot Bones;
+
+		/** Ground under each paw (indexed by EQuadrupedLeg) */
+		FCatFootTraceResult FootTraces[EQuadrupedLeg::Num];
+
+		/** Gait state and leg outputs from the batch subsystem, valid when bBatchedGait is set */
+		bool bBatchedGait = false;
+		FQuadrupedGaitState BatchedGaitState;
+		FQuadrupedLegGaitOutput BatchedGaitLegs[EQuadrupedLeg::Num];
+	};
+
+	FCatAnimGameThreadData GameThreadData;
 
 	/** Cached reference to skeletal mesh component */
 	UPROPERTY()
@@ -516,4 +863,31 @@ private:
 
 	/** Whether IK is currently enabled */
 	bool bIKEnabled = false;
+
+	/** Ground samples from the last frame that actually traced (see IKUpdateInterval) */
+	FCatFootTraceResult LastSolvedFootTraces[EQuadrupedLeg::Num];
+
+	/** LastSolvedFootTraces is usable, at LastSolvedIKLOD */
+	bool bHasSolvedFootTraces = false;
+	ECatIKLOD LastSolvedIKLOD = ECatIKLOD::Full;
+
+	/** Per-instance frame offset so reduced-rate cats don't all trace on the same frame */
+	uint32 IKStaggerIndex = 0;
+
+	/** Last FlightRecorderSeconds of IK state */
+	FSmartCatIKFlightRecorder IKFlightRecorder;
+
+	/** Flight recorder clock and previous frame's offsets for pop detection (worker thread) */
+	float FlightRecorderTime = 0.0f;
+	float FlightRecorderLastDumpTime = -FLT_MAX;
+	float FlightRecorderPrevFootOffset[EQuadrupedLeg::Num] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+	/** Anomaly bits raised by the worker, dumped by the next game thread update */
+	std::atomic<uint8> PendingFlightRecorderAnomalies { 0 };
+
+	/** Batched gait subsystem this instance is registered with */
+	TWeakObjectPtr<USmartCatGaitSubsystem> GaitSubsystem;
+
+	/** Slot in GaitSubsystem, INDEX_NONE when not registered */
+	int32 GaitSlot = INDEX_NONE;
 };
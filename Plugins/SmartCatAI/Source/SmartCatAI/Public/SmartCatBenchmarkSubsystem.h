@@ -0,0 +1,145 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SmartCatBenchmarkSubsystem.generated.h"
+
+class ASmartCatAICharacter;
+
+/**
+ * Settings for one cat-crowd benchmark run
+ */
+struct FSmartCatBenchmarkSettings
+{
+	/** Number of AI cats to spawn */
+	int32 NumCats = 64;
+
+	/** Frames measured after warm-up */
+	int32 NumFrames = 600;
+
+	/** Frames run before measuring (spawn, BT start, first traces) */
+	int32 WarmupFrames = 60;
+
+	/** Fixed simulation step used for the whole run */
+	float FixedDeltaTime = 1.0f / 60.0f;
+
+	/** Seed for the procedural terrain and spawn points */
+	int32 Seed = 1234;
+
+	/** Cat class to spawn; required, and must set a mesh and a USmartCatAnimInstance anim class */
+	TSubclassOf<ASmartCatAICharacter> CatClass;
+
+	/** Leave IK LOD on for the spawned cats; off by default since nothing renders under -nullrhi and LOD would switch IK off */
+	bool bEnableIKLOD = false;
+
+	/** Request engine exit once the report is written (for -nullrhi CI runs) */
+	bool bExitWhenDone = false;
+};
+
+/**
+ * Headless cat-crowd benchmark. Builds a procedural uneven-terrain patch in the current world,
+ * spawns NumCats cats possessed by ASmartCatAIController, runs a fixed number of frames at a fixed
+ * timestep and writes average/p99 game thread time, anim time and traces per frame as JSON to
+ * Saved/SmartCatBenchmark/.
+ *
+ * The spawned terrain has no navmesh, so unless the level's navigation already covers every spawn
+ * point the cats are walked by scripted movement input instead of their behavior tree. The report
+ * records which was used and the cats' average ground speed.
+ *
+ * From the console: SmartCat.Benchmark Class=<path> [Cats=64] [Frames=600] [Warmup=60] [Seed=1234] [IKLOD] [Exit]
+ * CI (Linux): UnrealEditor-Cmd <Project> <Map> -game -nullrhi -unattended -ExecCmds="SmartCat.Benchmark Class=/SmartCatAI/Blueprints/BP_SmartCatAI.BP_SmartCatAI_C Cats=128 Exit"
+ * Automation: the SmartCatAI.Benchmark.CatCrowd test runs a short pass in a fresh world [-SmartCatBenchmarkClass=<path>]
+ */
+UCLASS()
+class SMARTCATAI_API USmartCatBenchmarkSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Start a run; returns false (and logs why) if one is already running or the cats can't be spawned */
+	bool StartBenchmark(const FSmartCatBenchmarkSettings& InSettings);
+
+	bool IsRunning() const { return bRunning; }
+
+	/** JSON written by the last finished run, or empty if it failed to write */
+	const FString& GetLastReportPath() const { return LastReportPath; }
+
+	/** Frames measured by the last finished run */
+	int32 GetLastMeasuredFrames() const { return LastMeasuredFrames; }
+
+	/** Average horizontal cat speed (cm/s) over the measured frames of the last finished run */
+	double GetLastAverageCatSpeed() const { return LastAverageCatSpeed; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	/** Spawn the terrain tiles under the crowd */
+	void SpawnTerrain(FRandomStream& Random);
+
+	/** Spawn the cats above the terrain; false if any cat lacks a USmartCatAnimInstance */
+	bool SpawnCats(FRandomStream& Random);
+
+	/** True if the world's navigation covers every cat, so the behavior tree can move them */
+	bool HasNavigationForCats() const;
+
+	/** Steer the cats with movement input when there is no navigation for them */
+	void DriveCats(float DeltaTime);
+
+	/** Average horizontal speed of the live cats this frame (cm/s) */
+	double MeasureCatSpeed() const;
+
+	/** Write the JSON report and tear the run down */
+	void FinishBenchmark();
+
+	/** Destroy everything the run spawned and restore engine settings */
+	void Cleanup();
+
+	/** A spawned cat and, for scripted movement, where it is heading */
+	struct FCrowdCat
+	{
+		TWeakObjectPtr<ASmartCatAICharacter> Cat;
+		FVector Heading = FVector::ForwardVector;
+		float InputScale = 1.0f;
+		float SecondsUntilTurn = 0.0f;
+	};
+
+	FSmartCatBenchmarkSettings Settings;
+	bool bRunning = false;
+	int32 FrameIndex = 0;
+
+	TArray<FCrowdCat> Cats;
+
+	/** Cats are driven by DriveCats rather than their behavior tree */
+	bool bScriptedMovement = false;
+
+	/** Drives scripted headings; seeded from Settings.Seed so runs repeat */
+	FRandomStream MoveRandom;
+
+	/** Per measured frame, in milliseconds / counts */
+	TArray<double> GameThreadMs;
+	TArray<double> AnimMs;
+	TArray<double> TracesPerFrame;
+	TArray<double> CatSpeed;
+
+	/** Results of the last finished run */
+	FString LastReportPath;
+	int32 LastMeasuredFrames = 0;
+	double LastAverageCatSpeed = 0.0;
+
+	/** Engine fixed-timestep settings before the run */
+	bool bPrevUseFixedTimeStep = false;
+	double PrevFixedDeltaTime = 0.0;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AActor>> SpawnedActors;
+};
@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "QuadrupedGaitCalculator.h"
+#include "SmartCatGaitSubsystem.generated.h"
+
+/**
+ * Runs gait evaluation for the cats that asked for it this frame in one batch.
+ * Each anim instance owns a slot: on the game thread it submits its own gait state, inputs
+ * and delta time, and reads back the state and leg outputs computed by the previous batch.
+ * Cats that submit nothing (free slots, cats not in procedural gait) are not evaluated.
+ */
+UCLASS()
+class SMARTCATAI_API USmartCatGaitSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Claim a slot for a cat; returns its index */
+	int32 RegisterCat();
+
+	/** Release a slot claimed with RegisterCat */
+	void UnregisterCat(int32 Slot);
+
+	/** Game thread: queue the cat for the next batch, advancing State by the cat's own DeltaTime */
+	void SetCatInput(int32 Slot, const FQuadrupedGaitState& State, const FQuadrupedGaitConfig& Config,
+		const FVector& Velocity, const FVector& MoveDirection, float DeltaTime);
+
+	/** Game thread: read the results of the last batch. Returns false if the slot was not in it */
+	bool GetCatOutput(int32 Slot, FQuadrupedGaitState& OutState, FQuadrupedLegGaitOutput (&OutLegs)[EQuadrupedLeg::Num]) const;
+
+	/** Number of cats currently registered */
+	int32 GetNumRegisteredCats() const { return SlotActive.Num() - FreeSlots.Num(); }
+
+private:
+	/** This frame's requests, one entry per submitting cat (structure of arrays so the batch can take contiguous views) */
+	TArray<int32> RequestSlots;
+	TArray<FQuadrupedGaitState> RequestStates;
+	TArray<FQuadrupedGaitConfig> RequestConfigs;
+	TArray<FVector> RequestVelocities;
+	TArray<FVector> RequestMoveDirections;
+	TArray<float> RequestDeltaTimes;
+	TArray<FQuadrupedGaitLegOutputs> RequestLegOutputs;
+
+	/** Results of the last batch, one entry per slot */
+	TArray<FQuadrupedGaitState> States;
+	TArray<FQuadrupedGaitLegOutputs> LegOutputs;
+
+	/** Whether a slot is in use / was in the last batch */
+	TArray<bool> SlotActive;
+	TArray<bool> SlotEvaluated;
+
+	/** Index into the request arrays per slot, INDEX_NONE if it hasn't submitted this frame */
+	TArray<int32> SlotRequest;
+
+	/** Released slots available for reuse */
+	TArray<int32> FreeSlots;
+};
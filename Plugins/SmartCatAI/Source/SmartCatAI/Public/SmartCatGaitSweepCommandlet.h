@@ -0,0 +1,29 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SmartCatGaitSweepCommandlet.generated.h"
+
+/**
+ * Generates gait tables (the ExportGaitDataToCSV sweep) without loading a map
+ *
+ * Usage:
+ *   UnrealEditor-Cmd <Project> -run=SmartCatGaitSweep [-out=<file.csv|file.sctrace>] [-animclass=<AnimBP class path>]
+ *     [-minspeed=0] [-maxspeed=500] [-speedstep=25] [-timestep=0.016] [-duration=2]
+ *
+ * The gait config comes from the class default object of -animclass (a USmartCatAnimInstance
+ * subclass), or the default FQuadrupedGaitConfig when omitted. The output format follows the
+ * -out extension; the default is Saved/GaitData.csv.
+ */
+UCLASS()
+class SMARTCATAI_API USmartCatGaitSweepCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USmartCatGaitSweepCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
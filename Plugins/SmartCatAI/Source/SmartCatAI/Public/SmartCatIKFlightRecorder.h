@@ -0,0 +1,78 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "QuadrupedGaitCalculator.h"
+#include <atomic>
+
+/**
+ * One frame of IK state kept by the flight recorder (fixed size, ~100 bytes)
+ */
+struct FSmartCatIKFlightFrame
+{
+	/** Anomaly bits set by the anim instance's detector */
+	enum EAnomaly : uint8
+	{
+		None = 0,
+		NaNTarget = 1 << 0,
+		PinnedOffset = 1 << 1,
+		OffsetPop = 1 << 2,
+	};
+
+	float Time = 0.0f;
+	float GroundSpeed = 0.0f;
+	float GaitPhase = 0.0f;
+	float SlopePitch = 0.0f;
+	float SlopeRoll = 0.0f;
+	float PelvisOffsetZ = 0.0f;
+
+	float PawZ[EQuadrupedLeg::Num] = {};
+	float GroundZ[EQuadrupedLeg::Num] = {};
+	float FootOffset[EQuadrupedLeg::Num] = {};
+	float ResidualOffset[EQuadrupedLeg::Num] = {};
+	float IKAlpha[EQuadrupedLeg::Num] = {};
+
+	uint8 IKMode = 0;
+	uint8 IKLOD = 0;
+	uint8 Gait = 0;
+	uint8 Anomalies = None;
+};
+
+/**
+ * Fixed-memory ring buffer holding the most recent IK frames of one cat.
+ * One producer (the anim update) records every frame without locking; any thread may take a
+ * snapshot at any time. Each slot carries a sequence number so a snapshot skips the slot that
+ * is being overwritten instead of blocking the producer.
+ */
+class SMARTCATAI_API FSmartCatIKFlightRecorder
+{
+public:
+	/** Allocate Capacity frames. Drops anything recorded so far; not safe while recording */
+	void Initialize(int32 InCapacity);
+
+	bool IsInitialized() const { return Capacity > 0; }
+
+	/** Producer: overwrite the oldest frame */
+	void Record(const FSmartCatIKFlightFrame& Frame);
+
+	/** Copy the buffered frames, oldest first. Returns the number copied */
+	int32 Snapshot(TArray<FSmartCatIKFlightFrame>& OutFrames) const;
+
+	/** Write frames as CSV, with Reason on the first line */
+	static bool WriteCsv(const FString& Path, const FString& Reason, TConstArrayView<FSmartCatIKFlightFrame> Frames);
+
+private:
+	struct FSlot
+	{
+		/** Odd while the producer is writing Frame */
+		std::atomic<uint32> Sequence { 0 };
+		FSmartCatIKFlightFrame Frame;
+	};
+
+	TUniquePtr<FSlot[]> Slots;
+	int32 Capacity = 0;
+
+	/** Total frames recorded; the next write goes to WriteIndex % Capacity */
+	std::atomic<uint64> WriteIndex { 0 };
+};
@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Async/Future.h"
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
+class FSmartCatTraceWriter;
+
+/**
+ * One fixed-size row of runtime IK debug data (Z of each tracked bone and of the ground below it)
+ */
+struct FSmartCatIKDebugRow
+{
+	/** Tracked points, in column order */
+	enum EPoint : int32
+	{
+		FrontLeft = 0,
+		FrontRight,
+		BackLeft,
+		BackRight,
+		Bell,
+		Jaw,
+		NumPoints
+	};
+
+	float Time = 0.0f;
+	float Speed = 0.0f;
+	float BoneZ[NumPoints] = {};
+	float GroundZ[NumPoints] = {};
+};
+
+/**
+ * Records FSmartCatIKDebugRow to disk without touching the file system on the game thread.
+ * Rows are appended to an in-memory buffer; a background thread swaps it out and writes it
+ * to a columnar trace file (see SmartCatTraceFile.h) through a single open file handle.
+ * The trace is converted to CSV when recording stops.
+ */
+class SMARTCATAI_API FSmartCatIKRecorder : public FRunnable
+{
+public:
+	FSmartCatIKRecorder();
+	virtual ~FSmartCatIKRecorder();
+
+	/**
+	 * Open the trace file at BinaryPath and start the writer thread. CsvPath is written from it on StopRecording.
+	 * Waits for the previous recording's CSV conversion first, since it may still be reading the same trace file.
+	 */
+	bool StartRecording(const FString& InBinaryPath, const FString& InCsvPath);
+
+	/** Flush, close the file and convert it to CSV on a worker thread */
+	void StopRecording();
+
+	bool IsRecording() const { return Thread != nullptr; }
+
+	/** Game thread: queue a row for writing */
+	void AppendRow(const FSmartCatIKDebugRow& Row);
+
+	// FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+	/** Convert a trace file to CSV. Returns false if it is missing or malformed */
+	static bool ConvertBinaryToCsv(const FString& BinaryPath, const FString& CsvPath);
+
+	/** Rows buffered before the writer thread is woken early */
+	static constexpr int32 FlushRowThreshold = 256;
+
+	/** Writer thread wakes at least this often (ms) */
+	static constexpr uint32 FlushIntervalMs = 250;
+
+private:
+	/** Writer thread: write everything queued so far */
+	void FlushPendingRows();
+
+	/** Block until the last StopRecording's CSV conversion has finished */
+	void WaitForConversion();
+
+	FString BinaryPath;
+	FString CsvPath;
+
+	FRunnableThread* Thread = nullptr;
+	TUniquePtr<FSmartCatTraceWriter> Writer;
+	FEvent* FlushEvent = nullptr;
+	std::atomic<bool> bStopRequested { false };
+
+	/** Rows queued by the game thread, guarded by PendingLock */
+	FCriticalSection PendingLock;
+	TArray<FSmartCatIKDebugRow> PendingRows;
+
+	/** Rows being written by the writer thread (swapped with PendingRows) */
+	TArray<FSmartCatIKDebugRow> WritingRows;
+
+	/** CSV conversion of the last recording; the trace file must not be reopened until it completes */
+	TFuture<bool> ConversionResult;
+};
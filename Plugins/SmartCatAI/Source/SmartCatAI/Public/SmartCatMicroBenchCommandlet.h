@@ -0,0 +1,27 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SmartCatMicroBenchCommandlet.generated.h"
+
+/**
+ * Microbenchmarks for the pure gait and IK math (UpdateGaitState, leg outputs, gait batch,
+ * slope angles/residuals and the rig unit leg solve), reported in ns/op
+ *
+ * Usage:
+ *   UnrealEditor-Cmd <Project> -run=SmartCatMicroBench [-iterations=1000000] [-out=<file.csv>]
+ *
+ * Also available in a running game as the SmartCat.MicroBench [Iterations] console command.
+ */
+UCLASS()
+class SMARTCATAI_API USmartCatMicroBenchCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USmartCatMicroBenchCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,120 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SmartCatNavPointSubsystem.generated.h"
+
+/**
+ * What a pooled navmesh point is good for (bit flags)
+ */
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class ECatNavPointTag : uint8
+{
+	None       = 0 UMETA(Hidden),
+
+	/** Ground level with headroom */
+	OpenFloor  = 1 << 0 UMETA(DisplayName = "Open Floor"),
+
+	/** Raised above the floor next to it (shelf, table, wall top) */
+	Perch      = 1 << 1 UMETA(DisplayName = "Perch"),
+
+	/** Low ceiling overhead (under furniture) */
+	HidingSpot = 1 << 2 UMETA(DisplayName = "Hiding Spot"),
+};
+ENUM_CLASS_FLAGS(ECatNavPointTag);
+
+/**
+ * One pooled navmesh point
+ */
+struct FSmartCatNavPoint
+{
+	FVector Location = FVector::ZeroVector;
+	ECatNavPointTag Tags = ECatNavPointTag::None;
+};
+
+/**
+ * Pool of navmesh points for wander/escape destinations, kept in a 2D grid of CellSize cells.
+ * Cells are sampled every PointSpacing, keeping every navmesh layer at each spot, when play begins
+ * and re-sampled when the navigation system dirties their area, a few cells per tick and never
+ * while a nav build is running.
+ * Lookups probe a bounded number of random cells, so picking a point costs the same for any pool size.
+ */
+UCLASS()
+class SMARTCATAI_API USmartCatNavPointSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Random pool point between MinRadius and MaxRadius (2D) of Origin with any of RequiredTags (None = any).
+	 * Returns false if MaxSampleTries probes found nothing.
+	 */
+	bool FindWanderPoint(const FVector& Origin, float MinRadius, float MaxRadius, ECatNavPointTag RequiredTags, FVector& OutLocation) const;
+
+	/**
+	 * Pool point within MaxRadius (2D) of Origin that is farthest from Threat, and at least
+	 * MinThreatDistance from it, with any of RequiredTags (None = any). Returns false if none was found.
+	 */
+	bool FindEscapePoint(const FVector& Origin, const FVector& Threat, float MaxRadius, float MinThreatDistance, ECatNavPointTag RequiredTags, FVector& OutLocation) const;
+
+	/** Number of pooled points */
+	int32 GetNumPoints() const { return NumPoints; }
+
+	/** Whether cells are still waiting to be (re)sampled */
+	bool IsBuildPending() const { return PendingCells.Num() > 0; }
+
+	/** Grid cell edge length (cm) */
+	static constexpr float CellSize = 500.0f;
+
+	/** Distance between sample points inside a cell (cm) */
+	static constexpr float PointSpacing = 100.0f;
+
+	/** Cells (re)sampled per tick */
+	static constexpr int32 MaxCellsPerTick = 4;
+
+	/** Random cell probes per lookup */
+	static constexpr int32 MaxSampleTries = 16;
+
+private:
+	/** UNavigationSystemV1::NavigationDirtyEvent callback */
+	void HandleNavigationDirty(const FBox& DirtyBounds);
+
+	/** Queue every cell overlapping Bounds for (re)sampling */
+	void QueueCellsInBounds(const FBox& Bounds);
+
+	/** Replace a cell's points with a fresh sample of the navmesh */
+	void RebuildCell(const FIntPoint& Cell);
+
+	/** Tag a navmesh point from a few traces around it */
+	ECatNavPointTag ClassifyPoint(const FVector& Location) const;
+
+	/** Random point from a random cell around Origin (one probe); null if the probe hit an empty cell */
+	const FSmartCatNavPoint* ProbeRandomPoint(const FVector& Origin, float MinRadius, float MaxRadius) const;
+
+	static FIntPoint GetCellCoord(const FVector& Location);
+
+	/** Points per grid cell */
+	TMap<FIntPoint, TArray<FSmartCatNavPoint>> Cells;
+
+	/** Cells waiting to be (re)sampled, in queue order (set mirrors the array) */
+	TArray<FIntPoint> PendingCells;
+	TSet<FIntPoint> PendingCellSet;
+
+	/** Navigable bounds seen so far; every navmesh layer within its height is sampled */
+	FBox SampleBounds = FBox(ForceInit);
+
+	int32 NumPoints = 0;
+
+	FDelegateHandle NavigationDirtyHandle;
+};
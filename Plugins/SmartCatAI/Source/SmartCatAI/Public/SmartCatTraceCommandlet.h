@@ -0,0 +1,28 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SmartCatTraceCommandlet.generated.h"
+
+/**
+ * Offline converter/validator for SmartCatAI trace files (.sctrace)
+ *
+ * Usage:
+ *   UnrealEditor-Cmd <Project> -run=SmartCatTrace -in=<file.sctrace> [-out=<path>] [-format=csv|columns] [-validate]
+ *
+ * -format=csv (default) writes a CSV next to the input (or to -out);
+ * -format=columns writes one raw file per column plus schema.txt into the -out directory.
+ * -validate only checks the file and reports its schema, row count and NaN/Inf values.
+ */
+UCLASS()
+class SMARTCATAI_API USmartCatTraceCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USmartCatTraceCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,143 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IFileHandle;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * SmartCat trace files (.sctrace): versioned, columnar binary recordings of gait/IK data.
+ *
+ * Layout (little endian):
+ *   Header     uint32 Magic 'SCTF', uint16 Version, uint16 NumColumns,
+ *              then per column: uint8 Type, uint8 NameLength, NameLength bytes of UTF-8 name
+ *              (at most 255; longer names are cut at a character boundary),
+ *              zero padded to a multiple of 8 bytes
+ *   Row group  uint32 Magic 'RGRP', uint32 NumRows,
+ *              then per column: NumRows packed values, zero padded to a multiple of 4 bytes
+ *   ...        row groups repeat until end of file
+ *
+ * Each row group is flushed to the OS as it is written. A file cut off mid row group
+ * (e.g. by a crash) still reads: the partial group is dropped with a warning.
+ * Every column of a row group is 4-byte aligned, so a mapped file can be read in place.
+ */
+enum class ESmartCatTraceColumnType : uint8
+{
+	Float32 = 0,
+	UInt8 = 1,
+};
+
+struct FSmartCatTraceColumn
+{
+	FString Name;
+	ESmartCatTraceColumnType Type = ESmartCatTraceColumnType::Float32;
+
+	FSmartCatTraceColumn() = default;
+	FSmartCatTraceColumn(const FString& InName, ESmartCatTraceColumnType InType) : Name(InName), Type(InType) {}
+
+	/** Bytes per value */
+	int32 GetValueSize() const { return Type == ESmartCatTraceColumnType::Float32 ? sizeof(float) : sizeof(uint8); }
+};
+
+namespace SmartCatTrace
+{
+	constexpr uint32 FileMagic = 0x46544353; // 'SCTF'
+	constexpr uint32 RowGroupMagic = 0x50524752; // 'RGRP'
+	constexpr uint16 CurrentVersion = 1;
+	constexpr int32 DefaultRowGroupSize = 4096;
+}
+
+/**
+ * Streams rows into a trace file. Values are added column by column for each row
+ * (in schema order) and written out one row group at a time.
+ */
+class SMARTCATAI_API FSmartCatTraceWriter
+{
+public:
+	explicit FSmartCatTraceWriter(TArray<FSmartCatTraceColumn> InSchema, int32 InRowGroupSize = SmartCatTrace::DefaultRowGroupSize);
+	~FSmartCatTraceWriter();
+
+	/** Create the file and write the header */
+	bool Open(const FString& Path);
+
+	/** Write any buffered rows and close the file */
+	void Close();
+
+	bool IsOpen() const { return FileHandle != nullptr; }
+
+	/** Append the next value of the current row; must follow the schema order */
+	void AddFloat(float Value);
+	void AddUInt8(uint8 Value);
+
+	/** Finish the current row (writes a row group once RowGroupSize rows are buffered) */
+	void EndRow();
+
+	/** Write buffered rows as a (possibly short) row group and flush the file */
+	void FlushRowGroup();
+
+	const TArray<FSmartCatTraceColumn>& GetSchema() const { return Schema; }
+
+private:
+	TArray<FSmartCatTraceColumn> Schema;
+	int32 RowGroupSize;
+
+	/** Buffered values of the current row group, one byte array per column */
+	TArray<TArray<uint8>> ColumnData;
+	int32 BufferedRows = 0;
+	int32 NextColumn = 0;
+
+	IFileHandle* FileHandle = nullptr;
+};
+
+/**
+ * Reads a trace file, memory-mapped when the platform allows it (falls back to loading it).
+ */
+class SMARTCATAI_API FSmartCatTraceReader
+{
+public:
+	/** Column pointers into the file for one row group */
+	struct FRowGroup
+	{
+		int32 NumRows = 0;
+		TArray<const uint8*> Columns;
+	};
+
+	~FSmartCatTraceReader();
+
+	/** Open and index Path. A partial last row group is dropped with a warning; on failure OutError describes the first structural problem */
+	bool Open(const FString& Path, FString& OutError);
+
+	const TArray<FSmartCatTraceColumn>& GetSchema() const { return Schema; }
+	const TArray<FRowGroup>& GetRowGroups() const { return RowGroups; }
+	uint16 GetVersion() const { return Version; }
+	int64 GetNumRows() const;
+
+	float GetFloat(const FRowGroup& Group, int32 Column, int32 Row) const;
+	uint8 GetUInt8(const FRowGroup& Group, int32 Column, int32 Row) const;
+
+	/** Number of NaN/Inf float values (Open already validated the structure) */
+	int64 CountNonFiniteValues() const;
+
+	/** Write all rows as CSV (floats printed with enough digits to round-trip) */
+	bool ConvertToCsv(const FString& CsvPath) const;
+
+	/** Write one raw little-endian file per column plus schema.txt into Directory */
+	bool ConvertToColumnFiles(const FString& Directory) const;
+
+private:
+	bool Parse(FString& OutError);
+
+	TArray<FSmartCatTraceColumn> Schema;
+	TArray<FRowGroup> RowGroups;
+	uint16 Version = 0;
+
+	/** File contents: either mapped or loaded */
+	const uint8* Data = nullptr;
+	int64 DataSize = 0;
+	TArray<uint8> LoadedData;
+	IMappedFileHandle* MappedHandle = nullptr;
+	IMappedFileRegion* MappedRegion = nullptr;
+};